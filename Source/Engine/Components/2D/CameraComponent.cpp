@@ -45,57 +45,17 @@ namespace Reflex::Components
 		};
 	}
 
-	bool Camera::SetValue( const std::string& variable, const std::string& value )
+	void Camera::Reflect( Reflex::Core::TypeInfo& type )
 	{
 		static_assert( std::size( flagNames ) == ( size_t )NumFlags );
 
 		for( unsigned i = 0; i < std::size( flagNames ); ++i )
-		{
-			if( variable == flagNames[i] )
-			{
-				flags.set( i, Reflex::FromString< bool >( value ) );
-				return true;
-			}
-		}
-
-		if( variable == "PanSpeed" )
-		{
-			panSpeed = Reflex::FromString< sf::Vector2f >( value );
-			return true;
-		}
-		else if( variable == "PanMouseMargin" )
-		{
-			panMouseMargin = Reflex::FromString< sf::Vector2f >( value );
-			return true;
-		}
-		else if( variable == "FollowInterpSpeed" )
-		{
-			followInterpSpeed = Reflex::FromString< float >( value );
-			return true;
-		}
-		else if( variable == "ZoomScaleFactor" )
-		{
-			zoomScaleFactor = Reflex::FromString< float >( value );
-			return true;
-		}
+			type.ReflectFlag( Camera, flagNames[i], flags, i ).OmitDefault();
 
-		return false;
-	}
-
-	void Camera::GetValues( std::vector< std::pair< std::string, std::string > >& values ) const
-	{
-		for( unsigned i = 0; i < std::size( flagNames ); ++i )
-			if( flags.test( i ) )
-				values.emplace_back( flagNames[i], "true" );
-
-		if( !Reflex::IsDefault( panSpeed ) )
-			values.emplace_back( "PanSpeed", Reflex::ToString( panSpeed ) );
-		if( !Reflex::IsDefault( panMouseMargin ) )
-			values.emplace_back( "PanMouseMargin", Reflex::ToString( panMouseMargin ) );
-		if( followInterpSpeed )
-			values.emplace_back( "FollowInterpSpeed", Reflex::ToString( followInterpSpeed ) );
-		if( zoomScaleFactor )
-			values.emplace_back( "ZoomScaleFactor", Reflex::ToString( zoomScaleFactor ) );
+		type.ReflectField( Camera, "PanSpeed", panSpeed ).OmitDefault();
+		type.ReflectField( Camera, "PanMouseMargin", panMouseMargin ).OmitDefault();
+		type.ReflectField( Camera, "FollowInterpSpeed", followInterpSpeed ).OmitDefault();
+		type.ReflectField( Camera, "ZoomScaleFactor", zoomScaleFactor ).OmitDefault();
 	}
 
 	void Camera::OnConstructionComplete()
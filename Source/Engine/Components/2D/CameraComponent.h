@@ -16,8 +16,7 @@ namespace Reflex::Components
 		Camera( const Reflex::Object& owner, const sf::FloatRect& viewRect );
 		~Camera();
 
-		bool SetValue( const std::string& variable, const std::string& value ) override;
-		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
+		static void Reflect( Reflex::Core::TypeInfo& type );
 		static std::string GetComponentName() { return "Camera"; }
 		void OnConstructionComplete() final;
 
@@ -20,10 +20,17 @@ namespace Reflex::Components
 		void SetDensity( const float density, const bool recreate = true ) { m_density = density; if( recreate ) Recreate(); }
 		void OnConstructionComplete() final { Recreate(); }
 
-		virtual void Recreate()
+		// Subscriptions are bound to the old address, so resubscribe
+		void OnRelocated() final
 		{
 			const auto rigidBody = Component< T, RigidBody >::GetObject().template GetComponent< Components::RigidBody >();
 			rigidBody->Subscribe< Components::RigidBody::RigidBodyRecreatedEvent >( *this, &BaseCollider::OnRigidBodyRecreated );
+		}
+
+		virtual void Recreate()
+		{
+			const auto rigidBody = Component< T, RigidBody >::GetObject().template GetComponent< Components::RigidBody >();
+			rigidBody->template Subscribe< Components::RigidBody::RigidBodyRecreatedEvent >( *this, &BaseCollider::OnRigidBodyRecreated );
 
 			if( m_fixture )
 				rigidBody->GetBody().DestroyFixture( m_fixture );
@@ -56,6 +63,10 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "CircleCollider"; }
 		float GetRadius() const { return Reflex::ToWorldUnits( m_radius ); }
 		void SetRadius( const float radius, const bool recreate = true ) { m_radius = Reflex::ToBox2DUnits( radius ); if( recreate ) Recreate(); }
+
+		// The fixture is created from these once construction completes
+		void WriteSnapshot( Core::SnapshotWriter& writer ) const override { writer.Write( m_density ); writer.Write( m_radius ); writer.Write( m_p ); }
+		void ReadSnapshot( Core::SnapshotReader& reader ) override { m_density = reader.Read< float >(); m_radius = reader.Read< float >(); m_p = reader.Read< b2Vec2 >(); }
 	};
 
 	class RectangleCollider : public BaseCollider< RectangleCollider, b2PolygonShape >
@@ -72,6 +83,9 @@ namespace Reflex::Components
 		sf::Vector2f GetSize() const { return m_size; }
 		void SetSize( const sf::Vector2f& size, const bool recreate = true ) { m_size = size; if( recreate ) Recreate(); }
 
+		void WriteSnapshot( Core::SnapshotWriter& writer ) const override { writer.Write( m_density ); writer.Write( m_size ); }
+		void ReadSnapshot( Core::SnapshotReader& reader ) override { m_density = reader.Read< float >(); m_size = reader.Read< sf::Vector2f >(); }
+
 		void Recreate() final
 		{
 			const auto b2Size = Reflex::Vector2fToB2Vec( m_size );
@@ -110,6 +124,9 @@ namespace Reflex::Components
 		const std::vector< sf::Vector2f >& GetPoints() const { return m_points; }
 		void SetPoints( const std::vector< sf::Vector2f >& points, const bool recreate = true ) { m_points = points; if( recreate ) Recreate(); }
 
+		void WriteSnapshot( Core::SnapshotWriter& writer ) const override { writer.Write( m_density ); writer.WriteArray( m_points.data(), m_points.size() ); }
+		void ReadSnapshot( Core::SnapshotReader& reader ) override { m_density = reader.Read< float >(); reader.ReadArray( m_points ); }
+
 	protected:
 		std::vector< sf::Vector2f > m_points;
 	};
@@ -31,32 +31,11 @@ namespace Reflex::Components
 		m_children.resize( GetTotalCells() );
 	}
 
-	bool Grid::SetValue( const std::string& variable, const std::string& value )
+	void Grid::Reflect( Reflex::Core::TypeInfo& type )
 	{
-		if( variable == "GridSize" )
-		{
-			m_gridSize = Reflex::FromString< sf::Vector2u >( value );
-			return true;
-		}
-		else if( variable == "CellSize" )
-		{
-			m_cellSize = Reflex::FromString< sf::Vector2f >( value );
-			return true;
-		}
-		else if( variable == "CentreGrid" )
-		{
-			m_centreGrid = Reflex::FromString< bool >( value );
-			return true;
-		}
-
-		return false;
-	}
-
-	void Grid::GetValues( std::vector< std::pair< std::string, std::string > >& values ) const
-	{
-		values.emplace_back( "GridSize", Reflex::ToString( m_gridSize ) );
-		values.emplace_back( "CellSize", Reflex::ToString( m_cellSize ) );
-		values.emplace_back( "CentreGrid", Reflex::ToString( m_centreGrid ) );
+		type.ReflectField( Grid, "GridSize", m_gridSize );
+		type.ReflectField( Grid, "CellSize", m_cellSize );
+		type.ReflectField( Grid, "CentreGrid", m_centreGrid );
 	}
 
 	void Grid::AddToGrid( const Reflex::Object& handle, const unsigned x, const unsigned y )
@@ -12,35 +12,11 @@ namespace Reflex::Components
 
 	}
 
-	bool Interactable::SetValue( const std::string& variable, const std::string& value )
+	void Interactable::Reflect( Reflex::Core::TypeInfo& type )
 	{
-		if( variable == "SelectionIsToggle" )
-		{
-			selectionIsToggle = Reflex::FromString< bool >( value );
-			return true;
-		}
-		else if( variable == "UnselectIfLostFocus" )
-		{
-			unselectIfLostFocus = Reflex::FromString< bool >( value );
-			return true;
-		}
-		else if( variable == "IsEnabled" )
-		{
-			isEnabled = Reflex::FromString< bool >( value );
-			return true;
-		}
-
-		return false;
-	}
-
-	void Interactable::GetValues( std::vector< std::pair< std::string, std::string > >& values ) const
-	{
-		if( selectionIsToggle )
-			values.emplace_back( "SelectionIsToggle", "true" );
-		if( unselectIfLostFocus )
-			values.emplace_back( "UnselectIfLostFocus", "true" );
-		if( isEnabled )
-			values.emplace_back( "IsEnabled", "true" );
+		type.ReflectField( Interactable, "SelectionIsToggle", selectionIsToggle ).OmitDefault();
+		type.ReflectField( Interactable, "UnselectIfLostFocus", unselectIfLostFocus ).OmitDefault();
+		type.ReflectField( Interactable, "IsEnabled", isEnabled ).OmitDefault();
 	}
 
 	bool Interactable::IsFocussed() const
@@ -15,8 +15,7 @@ namespace Reflex::Components
 
 		Interactable( const Reflex::Object& owner, const Reflex::Object& collisionObjectOverride = Reflex::Object() );
 
-		bool SetValue( const std::string& variable, const std::string& value ) override;
-		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
+		static void Reflect( Reflex::Core::TypeInfo& type );
 		static std::string GetComponentName() { return "Interactable"; }
 
 		// Settings, change as you want
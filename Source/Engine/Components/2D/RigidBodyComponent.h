@@ -3,6 +3,7 @@
 #include "Components/Component.h"
 #include "TransformComponent.h"
 #include "Core/Events.h"
+#include "Core/Snapshot.h"
 
 namespace Reflex::Components
 {
@@ -49,17 +50,81 @@ namespace Reflex::Components
 			Recreate();
 		}
 
+		// Takes ownership of the physics body, the body's user data is pointed at the new owning object
+		RigidBody( RigidBody&& other )
+			: Component< RigidBody >( other )
+			, b2BodyDef( other )
+			, EventTriggerer( std::move( other ) )
+			, m_body( other.m_body )
+			, m_owningObject( other.m_owningObject )
+		{
+			other.m_body = nullptr;
+			userData = &m_owningObject;
+
+			if( m_body )
+				m_body->SetUserData( &m_owningObject );
+		}
+
 		~RigidBody()
 		{
-			GetObject().GetWorld().GetBox2DWorld().DestroyBody( m_body );
+			if( m_body )
+				GetObject().GetWorld().GetBox2DWorld().DestroyBody( m_body );
 		}
 
 		static std::string GetComponentName() { return "RigidBody"; }
 
 		sf::Vector2f GetPosition() const { return Reflex::B2VecToVector2f( m_body->GetPosition() ); }
 		float GetRotation() const { return Reflex::ToWorldUnits( m_body->GetAngle() ); }
+		bool IsAwake() const { return m_body->IsAwake(); }
 		b2Body& GetBody() { return *m_body; }
 
+		// Stores the body definition, plus the state of the body if it has been created
+		void WriteSnapshot( Core::SnapshotWriter& writer ) const override
+		{
+			writer.Write( type );
+			writer.Write( linearDamping );
+			writer.Write( angularDamping );
+			writer.Write( allowSleep );
+			writer.Write( fixedRotation );
+			writer.Write( bullet );
+			writer.Write( enabled );
+			writer.Write( gravityScale );
+			writer.Write( m_body != nullptr );
+
+			if( !m_body )
+				return;
+
+			writer.Write( m_body->GetPosition() );
+			writer.Write( m_body->GetAngle() );
+			writer.Write( m_body->GetLinearVelocity() );
+			writer.Write( m_body->GetAngularVelocity() );
+			writer.Write( m_body->IsAwake() );
+		}
+
+		// The transform must already have been read, as the body is recreated from its position
+		void ReadSnapshot( Core::SnapshotReader& reader ) override
+		{
+			type = reader.Read< b2BodyType >();
+			linearDamping = reader.Read< float >();
+			angularDamping = reader.Read< float >();
+			allowSleep = reader.Read< bool >();
+			fixedRotation = reader.Read< bool >();
+			bullet = reader.Read< bool >();
+			enabled = reader.Read< bool >();
+			gravityScale = reader.Read< float >();
+
+			if( !reader.Read< bool >() )
+				return;
+
+			const auto bodyPosition = reader.Read< b2Vec2 >();
+			angle = reader.Read< float >();
+			linearVelocity = reader.Read< b2Vec2 >();
+			angularVelocity = reader.Read< float >();
+			awake = reader.Read< bool >();
+			Recreate();
+			m_body->SetTransform( bodyPosition, angle );
+		}
+
 		struct RigidBodyRecreatedEvent
 		{
 			b2Body& oldBody;
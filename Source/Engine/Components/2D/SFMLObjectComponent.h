@@ -14,7 +14,8 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "CircleShape"; }
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
+		static constexpr bool IsPrefabClonable = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final { target.draw( *this, states ); }
 
 		void CreateRigidBody( const b2BodyType type = b2BodyType::b2_staticBody );
@@ -29,7 +30,8 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "RectangleShape"; }
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
+		static constexpr bool IsPrefabClonable = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final { target.draw( *this, states ); }
 
 		void CreateRigidBody( const b2BodyType type = b2BodyType::b2_staticBody );
@@ -45,7 +47,8 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "ConvexShape"; }
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
+		static constexpr bool IsPrefabClonable = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final { target.draw( *this, states ); }
 
 		void CreateRigidBody( const b2BodyType type = b2BodyType::b2_staticBody );
@@ -61,7 +64,8 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "Sprite"; }
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
+		static constexpr bool IsPrefabClonable = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final { target.draw( *this, states ); }
 	};
 
@@ -74,7 +78,8 @@ namespace Reflex::Components
 		static std::string GetComponentName() { return "Text"; }
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
+		static constexpr bool IsPrefabClonable = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final { target.draw( *this, states ); }
 	};
 
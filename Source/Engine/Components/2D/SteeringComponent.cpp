@@ -19,59 +19,36 @@ namespace Reflex::Components
 		"Obstacle Avoidance",
 	};
 
-	bool Steering::SetValue( const std::string& variable, const std::string& value )
-	{
-		TrySetValue( "MaxForce", m_maxForce );
-		TrySetValue( "Mass", m_mass );
-		TrySetValue( "SlowingRadius", m_slowingRadius );
-		TrySetValue( "WanderCircleRadius", m_wanderCircleRadius );
-		TrySetValue( "WanderJitter", m_wanderJitter );
-		TrySetValue( "WanderCircleDistance", m_wanderCircleDistance );
-		TrySetValue( "NeighbourRange", m_neighbourRange );
-		TrySetValue( "AlignmentForce", m_alignmentForce );
-		TrySetValue( "CohesionForce", m_cohesionForce );
-		TrySetValue( "SeparationForce", m_separationForce );
-
-		for( unsigned i = 0; i < std::size( steeringBehaviourNames ); ++i )
-		{
-			if( variable == steeringBehaviourNames[i] )
-			{
-				m_behaviours.set( i, Reflex::FromString< bool >( value ) );
-				return true;
-			}
-		}
-
-		return false;
-	}
-
-	void Steering::GetValues( std::vector< std::pair< std::string, std::string > >& values ) const
+	void Steering::Reflect( Reflex::Core::TypeInfo& type )
 	{
 		for( unsigned i = 0; i < std::size( steeringBehaviourNames ); ++i )
-			if( m_behaviours.test( i ) )
-				values.emplace_back( steeringBehaviourNames[i], "true" );
+			type.ReflectFlag( Steering, steeringBehaviourNames[i], m_behaviours, i ).OmitDefault();
 
-		GetValue( "MaxForce", m_maxForce );
-		GetValue( "Mass", m_maxForce );
-		TryGetValue( "SlowingRadius", m_slowingRadius, IsBehaviourSet( SteeringBehaviours::Arrival ) );
+		type.ReflectField( Steering, "MaxForce", m_maxForce );
+		type.ReflectField( Steering, "Mass", m_mass );
+		type.ReflectField( Steering, "SlowingRadius", m_slowingRadius ).SaveIf( []( const void* object )
+			{ return static_cast< const Steering* >( object )->IsBehaviourSet( SteeringBehaviours::Arrival ); } );
 
 		// Wander
-		if( IsBehaviourSet( SteeringBehaviours::Wander ) )
-		{
-			GetValue( "WanderCircleRadius", m_wanderCircleRadius );
-			GetValue( "WanderCircleDistance", m_wanderCircleDistance );
-			GetValue( "WanderJitter", m_wanderJitter );
-		}
+		const auto isWandering = []( const void* object ) { return static_cast< const Steering* >( object )->IsBehaviourSet( SteeringBehaviours::Wander ); };
+		type.ReflectField( Steering, "WanderCircleRadius", m_wanderCircleRadius ).SaveIf( isWandering );
+		type.ReflectField( Steering, "WanderCircleDistance", m_wanderCircleDistance ).SaveIf( isWandering );
+		type.ReflectField( Steering, "WanderJitter", m_wanderJitter ).SaveIf( isWandering );
 
 		// Flocking
-		if( IsBehaviourSet( SteeringBehaviours::Alignment ) ||
-			IsBehaviourSet( SteeringBehaviours::Cohesion ) ||
-			IsBehaviourSet( SteeringBehaviours::Separation ) )
+		type.ReflectField( Steering, "NeighbourRange", m_neighbourRange ).SaveIf( []( const void* object )
 		{
-			GetValue( "NeighbourRange", m_neighbourRange );
-			TryGetValue( "AlignmentForce", m_alignmentForce, IsBehaviourSet( SteeringBehaviours::Alignment ) );
-			TryGetValue( "CohesionForce", m_cohesionForce, IsBehaviourSet( SteeringBehaviours::Cohesion ) );
-			TryGetValue( "SeparationForce", m_separationForce, IsBehaviourSet( SteeringBehaviours::Separation ) );
-		}
+			const auto* steering = static_cast< const Steering* >( object );
+			return steering->IsBehaviourSet( SteeringBehaviours::Alignment ) ||
+				steering->IsBehaviourSet( SteeringBehaviours::Cohesion ) ||
+				steering->IsBehaviourSet( SteeringBehaviours::Separation );
+		} );
+		type.ReflectField( Steering, "AlignmentForce", m_alignmentForce ).SaveIf( []( const void* object )
+			{ return static_cast< const Steering* >( object )->IsBehaviourSet( SteeringBehaviours::Alignment ); } );
+		type.ReflectField( Steering, "CohesionForce", m_cohesionForce ).SaveIf( []( const void* object )
+			{ return static_cast< const Steering* >( object )->IsBehaviourSet( SteeringBehaviours::Cohesion ); } );
+		type.ReflectField( Steering, "SeparationForce", m_separationForce ).SaveIf( []( const void* object )
+			{ return static_cast< const Steering* >( object )->IsBehaviourSet( SteeringBehaviours::Separation ); } );
 	}
 
 	void Steering::Seek( const sf::Vector2f& target, const float maxVelocity )
@@ -33,8 +33,7 @@ namespace Reflex::Components
 		typedef std::bitset< ( size_t )SteeringBehaviours::NumBehaviours > BehaviourFlags;
 
 		using Component< Steering >::Component;
-		bool SetValue( const std::string& variable, const std::string& value ) override;
-		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
+		static void Reflect( Reflex::Core::TypeInfo& type );
 		static std::string GetComponentName() { return "Steering"; }
 
 		void Seek( const sf::Vector2f& target, const float maxVelocity );
@@ -63,7 +62,7 @@ namespace Reflex::Components
 		void SetTargetObject( const Reflex::Object& target );
 		void SetTargetPosition( const sf::Vector2f& location );
 
-		bool IsRenderComponent() const final { return true; }
+		static constexpr bool IsRenderComponent = true;
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final;
 
 		// Generic
@@ -103,5 +102,9 @@ namespace Reflex::Components
 		Reflex::Object m_targetObject;
 		sf::Vector2f m_targetPosition;
 		sf::Vector2f m_wanderDirection;
+
+		// Each boid has its own random state (seeded from its object on first use), so wandering boids can be updated in parallel
+		// and still get the same values whichever thread they run on (rand() state is per thread and unseeded on the workers)
+		std::uint32_t m_randomState = 0;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "TransformComponent.h"
 #include "Objects/Object.h"
 #include "Core/World.h"
+#include "Core/Snapshot.h"
 
 namespace Reflex::Components
 {
@@ -30,6 +31,22 @@ namespace Reflex::Components
 	{
 	}
 
+	Transform::Transform( Transform&& other )
+		: Component< Transform >( other )
+		, SceneNode( std::move( other ) )
+		, EventTriggerer( std::move( other ) )
+		, m_renderIndex( other.m_renderIndex )
+		, m_useTileMap( other.m_useTileMap )
+		, m_faceMovementDirection( other.m_faceMovementDirection )
+		, m_rotateDegreesPerSec( other.m_rotateDegreesPerSec )
+		, m_rotateDurationSec( other.m_rotateDurationSec )
+		, m_finishedRotationCallback( std::move( other.m_finishedRotationCallback ) )
+		, m_velocity( other.m_velocity )
+		, m_maxVelocity( other.m_maxVelocity )
+		, localBounds( other.localBounds )
+	{
+	}
+
 	void Transform::OnConstructionComplete()
 	{
 		if( m_useTileMap )
@@ -80,37 +97,96 @@ namespace Reflex::Components
 		values.emplace_back( "Scale", Reflex::ToString( getScale() ) );
 	}
 
+	void Transform::WriteSnapshot( Core::SnapshotWriter& writer ) const
+	{
+		// The parent / children are stored by the world with the rest of the scene graph
+		writer.Write( getPosition() );
+		writer.Write( getRotation() );
+		writer.Write( getScale() );
+		writer.Write( getOrigin() );
+		writer.Write( m_renderIndex );
+		writer.Write( m_useTileMap );
+		writer.Write( m_faceMovementDirection );
+		writer.Write( m_rotateDegreesPerSec );
+		writer.Write( m_rotateDurationSec );
+		writer.Write( m_velocity );
+		writer.Write( m_maxVelocity );
+		writer.Write( localBounds );
+	}
+
+	void Transform::ReadSnapshot( Core::SnapshotReader& reader )
+	{
+		// Read before the transform is inserted into the tile map (OnConstructionComplete), so the position can be set directly
+		Transformable::setPosition( reader.Read< sf::Vector2f >() );
+		Transformable::setRotation( reader.Read< float >() );
+		Transformable::setScale( reader.Read< sf::Vector2f >() );
+		Transformable::setOrigin( reader.Read< sf::Vector2f >() );
+		m_renderIndex = reader.Read< unsigned >();
+		m_useTileMap = reader.Read< bool >();
+		m_faceMovementDirection = reader.Read< bool >();
+		m_rotateDegreesPerSec = reader.Read< float >();
+		m_rotateDurationSec = reader.Read< float >();
+		m_velocity = reader.Read< sf::Vector2f >();
+		m_maxVelocity = reader.Read< float >();
+		localBounds = reader.Read< Reflex::BoundingBox >();
+		OnTransformChanged();
+	}
+
 	void Transform::setPosition( float x, float y )
 	{
 		Transform::setPosition( sf::Vector2f( x, y ) );
 	}
 
 	void Transform::setPosition( const sf::Vector2f& position )
+	{
+		if( const auto move = SetPositionDeferred( position ) )
+		{
+			auto& tileMap = GetWorld().GetTileMap();
+			tileMap.Remove( move->object, move->previousChunk, move->previousCell );
+			tileMap.Insert( move->object );
+		}
+	}
+
+	std::optional< Transform::TileMapMove > Transform::SetPositionDeferred( const sf::Vector2f& position )
 	{
 		assert( !std::isinf( position.x ) && !std::isinf( position.y ) );
 
 #ifndef DISABLE_TILEMAP
 		if( m_useTileMap )
 		{
-			auto& tileMap = GetWorld().GetTileMap();
+			const auto& tileMap = GetWorld().GetTileMap();
 
 			const auto prevCellId = tileMap.GetCellId( Component::GetObject() );
 			const auto prevChunkHash = tileMap.ChunkHash( Component::GetObject() );
 
 			sf::Transformable::setPosition( position );
+			OnTransformChanged();
 
 			if( prevCellId != tileMap.GetCellId( Component::GetObject() ) ||
 				prevChunkHash != tileMap.ChunkHash( Component::GetObject() ) )
-			{
-				tileMap.Remove( Component::GetObject(), prevChunkHash, prevCellId );
-				tileMap.Insert( Component::GetObject() );
-			}
+				return TileMapMove{ Component::GetObject(), prevChunkHash, prevCellId };
 
-			return;
+			return std::nullopt;
 		}
 #endif
 
 		sf::Transformable::setPosition( position );
+		OnTransformChanged();
+		return std::nullopt;
+	}
+
+	void Transform::ApplyTileMapMoves( std::vector< TileMapMove >& moves )
+	{
+		std::sort( moves.begin(), moves.end(), []( const TileMapMove& a, const TileMapMove& b ) { return a.object.GetIndex() < b.object.GetIndex(); } );
+
+		for( const auto& move : moves )
+		{
+			auto& tileMap = move.object.GetWorld().GetTileMap();
+			tileMap.Remove( move.object, move.previousChunk, move.previousCell );
+			tileMap.Insert( move.object );
+		}
+
+		moves.clear();
 	}
 
 	void Transform::move( float offsetX, float offsetY )
@@ -127,12 +203,44 @@ namespace Reflex::Components
 	{
 		Transformable::setScale( scale );
 		assert( scale.x != 0.0f || scale.y != 0.0f );
+		OnTransformChanged();
 	}
 
 	void Transform::setScale( const float scaleX, const float scaleY )
 	{
 		Transformable::setScale( scaleX, scaleY );
 		assert( scaleX != 0.0f || scaleY != 0.0f );
+		OnTransformChanged();
+	}
+
+	void Transform::setRotation( const float angle )
+	{
+		Transformable::setRotation( angle );
+		OnTransformChanged();
+	}
+
+	void Transform::rotate( const float angle )
+	{
+		Transformable::rotate( angle );
+		OnTransformChanged();
+	}
+
+	void Transform::setOrigin( const float x, const float y )
+	{
+		Transformable::setOrigin( x, y );
+		OnTransformChanged();
+	}
+
+	void Transform::setOrigin( const sf::Vector2f& origin )
+	{
+		Transformable::setOrigin( origin );
+		OnTransformChanged();
+	}
+
+	void Transform::OnTransformChanged()
+	{
+		InvalidateWorldTransform();
+		MarkChanged();
 	}
 
 	void Transform::RotateForDuration( const float degrees, const float durationSec )
@@ -17,24 +17,47 @@ namespace Reflex::Components
 
 		Transform( const Reflex::Object& owner, const sf::Vector2f& position = {}, const float rotation = 0.0f, const sf::Vector2f & scale = sf::Vector2f( 1.0f, 1.0f ), const bool useTileMap = true );
 		Transform( const Transform& other );
+		Transform( Transform&& other );
 
 		void OnConstructionComplete();
 		void OnDestructionBegin() override;
 
 		bool SetValue( const std::string& variable, const std::string& value ) override;
 		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override;
+		void WriteSnapshot( Core::SnapshotWriter& writer ) const override;
+		void ReadSnapshot( Core::SnapshotReader& reader ) override;
 		static std::string GetComponentName() { return "Transform"; }
 		static void RegisterSerialisedValues() {}
 
 		void setPosition( float x, float y );
 		void setPosition( const sf::Vector2f& position );
 
+		// Object that moved to a different tile map cell, removed from the cell it was in and inserted into its new one by ApplyTileMapMoves
+		struct TileMapMove
+		{
+			Reflex::Object object;
+			sf::Vector2i previousChunk;
+			unsigned previousCell = 0U;
+		};
+
+		// For moving objects from multiple threads at once, the tile map is left alone (returning the move if the object changed cell)
+		std::optional< TileMapMove > SetPositionDeferred( const sf::Vector2f& position );
+
+		// Applies the moves in object order, so the tile map ends up the same however the moves were split across threads
+		static void ApplyTileMapMoves( std::vector< TileMapMove >& moves );
+
 		void move( float offsetX, float offsetY );
 		void move( const sf::Vector2f& offset );
 
 		void setScale( const sf::Vector2f scale );
 		void setScale( const float scaleX, const float scaleY );
 
+		void setRotation( const float angle );
+		void rotate( const float angle );
+
+		void setOrigin( const float x, const float y );
+		void setOrigin( const sf::Vector2f& origin );
+
 		void RotateForDuration( const float degrees, const float durationSec );
 		void RotateForDuration( const float degrees, const float durationSec, std::function< void( const Transform::Handle& ) > finishedRotationCallback );
 		void StopRotation();
@@ -67,6 +90,9 @@ namespace Reflex::Components
 		void SetFaceMovementDirection( const bool faceMovement ) { m_faceMovementDirection = faceMovement; }
 
 	protected:
+		// Every change to the local transform goes through here, to stamp the change tick and invalidate the cached world transforms
+		void OnTransformChanged();
+
 		unsigned m_renderIndex = 0U;
 		static unsigned s_nextRenderIndex;
 
@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "Component.h"
 #include "Objects/Object.h"
+#include "Core/World.h"
+#include "Core/Snapshot.h"
 
 namespace Reflex::Components
 {
@@ -8,16 +10,49 @@ namespace Reflex::Components
 
 	BaseComponent::BaseComponent( const Object& object )
 		: m_object( object )
+		, m_changeTick( object.GetWorld().GetChangeTick() )
 	{
 
 	}
 
 	BaseComponent::BaseComponent( const BaseComponent& other )
 		: m_object( other.m_object )
+		, m_changeTick( other.m_changeTick )
 	{
 
 	}
 
+	void BaseComponent::MarkChanged( const ComponentFamily family )
+	{
+		auto& world = GetWorld();
+		m_changeTick = world.GetChangeTick();
+		world.MarkComponentChanged( family );
+	}
+
+	void BaseComponent::WriteSnapshot( Reflex::Core::SnapshotWriter& writer ) const
+	{
+		std::vector< std::pair< std::string, std::string > > values;
+		GetValues( values );
+		writer.Write( ( std::uint32_t )values.size() );
+
+		for( const auto& [variable, value] : values )
+		{
+			writer.WriteString( variable );
+			writer.WriteString( value );
+		}
+	}
+
+	void BaseComponent::ReadSnapshot( Reflex::Core::SnapshotReader& reader )
+	{
+		const auto count = reader.Read< std::uint32_t >();
+
+		for( std::uint32_t i = 0; i < count; ++i )
+		{
+			const auto variable = reader.ReadString();
+			SetValue( variable, reader.ReadString() );
+		}
+	}
+
 	Reflex::Object BaseComponent::GetObject() const
 	{
 		return m_object;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Objects/BaseObject.h"
+#include "Core/Reflection.h"
 
 #undef GetObject
 
@@ -11,7 +12,7 @@ namespace Reflex
 	template< class T >
 	class Handle;
 
-	namespace Core { class World; }
+	namespace Core { class World; class SnapshotWriter; class SnapshotReader; }
 	namespace Systems { class RenderSystem; }
 }
 
@@ -31,23 +32,54 @@ namespace Reflex::Components
 		Reflex::Handle< Transform > GetTransform() const;
 		Reflex::Core::World& GetWorld() const;
 
+		// World change tick the component was last changed in (see World::GetChangeTick), stamped when it is constructed and by MarkChanged
+		std::uint32_t GetChangeTick() const { return m_changeTick; }
+		bool ChangedSince( const std::uint32_t tick ) const { return std::int32_t( m_changeTick - tick ) > 0; }
+
+		// Render components hide this with true (read once when the type is registered, see World::GetRenderComponents)
+		static constexpr bool IsRenderComponent = false;
+
+		// Components which are fully described by their values (nothing tied to the object they belong to) hide this with true
+		// Prefabs then copy construct them from a prototype rather than applying their values one at a time
+		static constexpr bool IsPrefabClonable = false;
+
 	protected:
 		BaseComponent() {}
 		BaseComponent( const BaseComponent& other );
 		virtual ~BaseComponent() {}
 		virtual void OnConstructionComplete() = 0;
 		virtual void OnDestructionBegin() = 0;
+		// Called after the component has been moved to a new address in its pool (due to another component of the same type being removed)
+		virtual void OnRelocated() { }
 		static std::string GetComponentName() { assert( false ); }
 
-		// Serialisation
+		// Stamps the component (and its family) with the current change tick
+		void MarkChanged( const ComponentFamily family );
+
+		// Serialisation (reflected components get these from their reflection table, see Component::GetTypeInfo)
 		virtual bool SetValue( const std::string& variable, const std::string& value ) { return false; }
 		virtual void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const { }
 
+		// Binary snapshots (see World::SaveSnapshot), by default the serialised values above are stored
+		// Components with state the values don't cover (or that are saved in large numbers) should write their members directly
+		virtual void WriteSnapshot( Reflex::Core::SnapshotWriter& writer ) const;
+		virtual void ReadSnapshot( Reflex::Core::SnapshotReader& reader );
+
+		// Only the given reflected fields, in order (prefabs store the fields their file sets like this, so instances never parse strings)
+		virtual void WriteFields( const std::vector< const Reflex::Core::FieldInfo* >& fields, Reflex::Core::SnapshotWriter& writer ) const { }
+		virtual void ReadFields( const std::vector< const Reflex::Core::FieldInfo* >& fields, Reflex::Core::SnapshotReader& reader ) { }
+
 		// Component rendering
-		virtual bool IsRenderComponent() const { return false; }
 		virtual void Render( sf::RenderTarget& target, sf::RenderStates states ) const { }
 
+		static ComponentFamily NextFamily()
+		{
+			assert( s_componentFamilyIdx < MaxComponents );
+			return s_componentFamilyIdx++;
+		}
+
 		BaseObject m_object;
+		std::uint32_t m_changeTick = 0;
 		static ComponentFamily s_componentFamilyIdx;
 	};
 
@@ -63,38 +95,86 @@ namespace Reflex::Components
 		typedef Reflex::Handle< T > Handle;
 		Handle GetHandle() const { return Handle( GetObject() ); }
 
-		static ComponentFamily GetFamily()
-		{
-			static ComponentFamily s_family = s_componentFamilyIdx++;
-			assert( s_family < MaxComponents );
-			return s_family;
-		}
+		static ComponentFamily GetFamily() { return s_family; }
+
+		// Call after modifying the component outside of its own setters, so systems iterating changed components pick it up
+		void MarkChanged() { BaseComponent::MarkChanged( s_family ); }
 
 		static ComponentsMask GetRequiredComponents()
 		{
 			ComponentsMask mask;
-			unsigned long ul;
-			ul = ( ( 1 << RequiresComponents::GetFamily() ) | ... | 0 );
-			return ComponentsMask( ul );
+			( mask.set( RequiresComponents::GetFamily() ), ... );
+			return mask;
 		}
 
 		virtual void OnConstructionComplete() override { };
 		virtual void OnDestructionBegin() override { }
 
+		// Components opt in to reflection by defining a public static void Reflect( Reflex::Core::TypeInfo& type ) which adds their fields
+		// Serialisation and snapshots then go through the table, overriding SetValue / GetValues is only needed for values that aren't plain members
+		static constexpr bool IsReflected() { return requires( Reflex::Core::TypeInfo& type ) { T::Reflect( type ); }; }
+
+		static const Reflex::Core::TypeInfo& GetTypeInfo()
+		{
+			static_assert( IsReflected(), "Component type has no Reflect function" );
+			static const Reflex::Core::TypeInfo typeInfo = []()
+			{
+				Reflex::Core::TypeInfo type;
+				T::Reflect( type );
+				return type;
+			}();
+			return typeInfo;
+		}
+
 	protected:
 		using BaseComponent::BaseComponent;
-	};
-}
 
-// Helper macros used for serialisation
-#define TrySetValue( name, mem ) \
-	if( variable == name ) { \
-		mem = Reflex::FromString< decltype( mem ) >( value ); \
-		return true; } 
+		bool SetValue( const std::string& variable, const std::string& value ) override
+		{
+			if constexpr( IsReflected() )
+				return GetTypeInfo().SetValue( static_cast< T* >( this ), variable, value );
+			else
+				return false;
+		}
 
-#define GetValue( name, mem ) \
-	values.emplace_back( name, Reflex::ToString( mem ) );
+		void GetValues( std::vector< std::pair< std::string, std::string > >& values ) const override
+		{
+			if constexpr( IsReflected() )
+				GetTypeInfo().GetValues( static_cast< const T* >( this ), values );
+		}
 
-#define TryGetValue( name, mem, cond ) \
-	if( cond ) \
-		values.emplace_back( name, Reflex::ToString( mem ) );
+		void WriteSnapshot( Reflex::Core::SnapshotWriter& writer ) const override
+		{
+			if constexpr( IsReflected() )
+				GetTypeInfo().WriteSnapshot( static_cast< const T* >( this ), writer );
+			else
+				BaseComponent::WriteSnapshot( writer );
+		}
+
+		void ReadSnapshot( Reflex::Core::SnapshotReader& reader ) override
+		{
+			if constexpr( IsReflected() )
+				GetTypeInfo().ReadSnapshot( static_cast< T* >( this ), reader );
+			else
+				BaseComponent::ReadSnapshot( reader );
+		}
+
+		void WriteFields( const std::vector< const Reflex::Core::FieldInfo* >& fields, Reflex::Core::SnapshotWriter& writer ) const override
+		{
+			if constexpr( IsReflected() )
+				for( const auto* field : fields )
+					field->write( *field, static_cast< const T* >( this ), writer );
+		}
+
+		void ReadFields( const std::vector< const Reflex::Core::FieldInfo* >& fields, Reflex::Core::SnapshotReader& reader ) override
+		{
+			if constexpr( IsReflected() )
+				for( const auto* field : fields )
+					field->read( *field, static_cast< T* >( this ), reader );
+		}
+
+	private:
+		// Assigned once during static initialisation (so GetFamily has no init guard), must not be queried from other static initialisers
+		static inline const ComponentFamily s_family = NextFamily();
+	};
+}
\ No newline at end of file
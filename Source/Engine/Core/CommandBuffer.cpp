@@ -0,0 +1,134 @@
+#include "Precompiled.h"
+#include "CommandBuffer.h"
+#include "World.h"
+#include "Objects/Object.h"
+
+namespace Reflex::Core
+{
+	void CommandBuffer::CreateObject( const sf::Vector2f& position, const float rotation, const sf::Vector2f& scale, const bool attachToRoot, const bool useTileMap, CreatedCallback onCreated )
+	{
+		m_commands.push_back( { CommandType::Create, BaseObject(), 0, [=]( World& world )
+		{
+			const auto object = world.CreateObject( position, rotation, scale, attachToRoot, useTileMap );
+
+			if( onCreated )
+				onCreated( object );
+		} } );
+	}
+
+	void CommandBuffer::DestroyObject( const BaseObject& object )
+	{
+		m_commands.push_back( { CommandType::Destroy, object } );
+	}
+
+	void CommandBuffer::Flush( World& world )
+	{
+		// Commands recorded during the flush (from created callbacks or component hooks) are picked up by the next pass
+		// Each pass works on its own local list, so a callback flushing the buffer again only applies what was recorded since
+		std::vector< Command > flushing;
+
+		while( !m_commands.empty() )
+		{
+			flushing.clear();
+			flushing.swap( m_commands );
+			SortAndCoalesce( world, flushing );
+
+			for( auto& command : flushing )
+			{
+				if( command.cancelled )
+					continue;
+
+				if( command.type == CommandType::Create )
+				{
+					command.apply( world );
+					continue;
+				}
+
+				// The object may have been destroyed since the command was recorded
+				if( !world.IsValidObject( command.object ) )
+					continue;
+
+				switch( command.type )
+				{
+				case CommandType::AddComponent: command.apply( world ); break;
+				case CommandType::RemoveComponent: world.ObjectRemoveComponent( command.object, command.family ); break;
+				case CommandType::Destroy: world.DestroyObject( command.object ); break;
+				default: break;
+				}
+			}
+		}
+	}
+
+	void CommandBuffer::Append( CommandBuffer& other )
+	{
+		m_commands.insert( m_commands.end(), std::make_move_iterator( other.m_commands.begin() ), std::make_move_iterator( other.m_commands.end() ) );
+		other.m_commands.clear();
+	}
+
+	void CommandBuffer::SortAndCoalesce( const World& world, std::vector< Command >& commands )
+	{
+		// Creates first (in the order recorded), then component changes grouped by object, then destroys
+		// The sort is stable so changes to the same object keep the order they were recorded in
+		std::stable_sort( commands.begin(), commands.end(), []( const Command& a, const Command& b )
+		{
+			const auto groupA = a.type == CommandType::Create ? 0 : a.type == CommandType::Destroy ? 2 : 1;
+			const auto groupB = b.type == CommandType::Create ? 0 : b.type == CommandType::Destroy ? 2 : 1;
+
+			if( groupA != groupB )
+				return groupA < groupB;
+
+			return groupA != 0 && a.object.GetIndex() < b.object.GetIndex();
+		} );
+
+		std::unordered_set< BaseObject > destroyed;
+		for( const auto& command : commands )
+			if( command.type == CommandType::Destroy )
+				destroyed.insert( command.object );
+
+		// Adds on the current object that will create a new component (the object doesn't have it), by family
+		std::vector< std::pair< ComponentFamily, std::size_t > > pendingAdds;
+		ComponentsMask hasComponents;
+
+		for( std::size_t i = 0; i < commands.size(); ++i )
+		{
+			auto& command = commands[i];
+
+			if( command.type != CommandType::AddComponent && command.type != CommandType::RemoveComponent )
+				continue;
+
+			// Component changes to an object that is about to be destroyed (or already has been) are pointless
+			if( !world.IsValidObject( command.object ) || destroyed.find( command.object ) != destroyed.end() )
+			{
+				command.cancelled = true;
+				continue;
+			}
+
+			if( i == 0 || commands[i - 1].object != command.object )
+			{
+				pendingAdds.clear();
+				hasComponents = world.ObjectGetComponentFlags( command.object );
+			}
+
+			if( command.type == CommandType::AddComponent )
+			{
+				if( !hasComponents.test( command.family ) )
+					pendingAdds.emplace_back( command.family, i );
+
+				hasComponents.set( command.family );
+				continue;
+			}
+
+			const auto found = std::find_if( pendingAdds.begin(), pendingAdds.end(), [&]( const auto& pending ) { return pending.first == command.family; } );
+
+			// Add then remove on the same object, neither needs to happen
+			if( found != pendingAdds.end() )
+			{
+				commands[found->second].cancelled = true;
+				command.cancelled = true;
+				pendingAdds.erase( found );
+			}
+
+			hasComponents.reset( command.family );
+		}
+	}
+}
\ No newline at end of file
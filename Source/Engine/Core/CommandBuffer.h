@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Objects/BaseObject.h"
+
+namespace Reflex { class Object; }
+
+namespace Reflex::Core
+{
+	class World;
+
+	// Records structural changes (creating / destroying objects, adding / removing components) so they can be applied later at a sync point
+	// Systems should record changes here during their update instead of changing the world directly, so no system's object list changes while another is iterating it
+	// Flushing applies the commands grouped by object, and an add followed by a remove of the same component on the same object cancels out
+	class CommandBuffer
+	{
+	public:
+		// Called with the new object during the flush, changes made from the callback are applied immediately
+		typedef std::function< void( const Reflex::Object& ) > CreatedCallback;
+
+		void CreateObject( const sf::Vector2f& position = {}, const float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f( 1.0f, 1.0f ), const bool attachToRoot = true, const bool useTileMap = true, CreatedCallback onCreated = nullptr );
+		void DestroyObject( const BaseObject& object );
+
+		// Arguments are copied into the command, so they must still be valid when the buffer is flushed
+		template< class T, typename... Args >
+		void AddComponent( const BaseObject& object, Args&& ... args );
+
+		template< class T >
+		void RemoveComponent( const BaseObject& object );
+
+		// Applies every recorded command, anything recorded while flushing is applied before this returns
+		void Flush( World& world );
+
+		// Moves the other buffer's commands onto the end of this one
+		void Append( CommandBuffer& other );
+
+		bool Empty() const { return m_commands.empty(); }
+		std::size_t Size() const { return m_commands.size(); }
+
+	private:
+		enum class CommandType : std::uint8_t
+		{
+			Create,
+			AddComponent,
+			RemoveComponent,
+			Destroy,
+		};
+
+		struct Command
+		{
+			CommandType type;
+			BaseObject object;
+			ComponentFamily family = 0;
+			std::function< void( World& ) > apply;
+			bool cancelled = false;
+		};
+
+		static void SortAndCoalesce( const World& world, std::vector< Command >& commands );
+
+		std::vector< Command > m_commands;
+	};
+
+	template< class T, typename... Args >
+	void CommandBuffer::AddComponent( const BaseObject& object, Args&& ... args )
+	{
+		// Generic lambda so the call into World is only instantiated where World is a complete type
+		m_commands.push_back( { CommandType::AddComponent, object, T::GetFamily(), [object, arguments = std::make_tuple( std::forward< Args >( args )... )]( auto& world ) mutable
+		{
+			std::apply( [&]( auto& ... unpacked ) { world.template ObjectAddComponent< T >( object, std::move( unpacked )... ); }, arguments );
+		} } );
+	}
+
+	template< class T >
+	void CommandBuffer::RemoveComponent( const BaseObject& object )
+	{
+		m_commands.push_back( { CommandType::RemoveComponent, object, T::GetFamily() } );
+	}
+}
\ No newline at end of file
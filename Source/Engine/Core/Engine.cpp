@@ -6,14 +6,14 @@
 namespace Reflex::Core
 {
 	Engine::Engine( const std::string& windowName, const bool fullscreen )
-		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity )
+		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity, m_params.componentStorage, m_params.worldMemoryResource )
 		, m_stateManager( m_world )
 	{
 		Setup();
 	}
 
 	Engine::Engine( const std::string& windowName, const int screenWidth, const int screenHeight )
-		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity )
+		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity, m_params.componentStorage, m_params.worldMemoryResource )
 		, m_stateManager( m_world )
 	{
 		m_params.videoMode.width = screenWidth;
@@ -23,14 +23,14 @@ namespace Reflex::Core
 
 	Engine::Engine( const Engine::EngineParams& params )
 		: m_params( params )
-		, m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity )
+		, m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity, m_params.componentStorage, m_params.worldMemoryResource )
 		, m_stateManager( m_world )
 	{
 		Setup();
 	}
 
 	Engine::Engine( const bool createWindow, const int fixedUpdatesPerSecond, const bool enableProfiling )
-		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity )
+		: m_world( Context( m_window, m_textureManager, m_fontManager ), m_params.worldBounds, m_params.gravity, m_params.componentStorage, m_params.worldMemoryResource )
 		, m_stateManager( m_world )
 	{
 		m_params.cmdMode = !createWindow;
@@ -43,6 +43,10 @@ namespace Reflex::Core
 	void Engine::Setup()
 	{
 		srand( (unsigned )time( 0 ) );
+		m_world.SetIndexReuse( m_params.objectIndexReuse );
+
+		if( m_params.useLargePages && !ComponentAllocatorBase::EnableLargePages() )
+			LOG_WARN( "Large pages requested but unavailable (the user needs the Lock pages in memory privilege), using normal allocations" );
 
 		if( !m_params.cmdMode )
 		{
@@ -80,6 +84,10 @@ namespace Reflex::Core
 					Profiler::GetProfiler().FrameTick( deltaTime.asMicroseconds() );
 #endif
 
+				// Finish resources decoded in the background (textures can only be uploaded from the main thread)
+				m_textureManager.Update();
+				m_fontManager.Update();
+
 				accumlatedTime += deltaTime;
 				unsigned counter = 0;
 				const auto interval = sf::seconds( 1.0f / m_params.fixedUpdatesPerSecond );
@@ -169,13 +177,13 @@ namespace Reflex::Core
 		ImGui::SetNextWindowPos( sf::Vector2( 5.0f, 5.0f ), ImGuiCond_::ImGuiCond_Once );
 		ImGui::SetNextWindowSize( sf::Vector2( 200.0f, 200.0f ), ImGuiCond_::ImGuiCond_Once );
 		ImGui::Begin( "Engine Info" );
-		ImGui::Text( m_statisticsText.toAnsiString().c_str() );
+		ImGui::Text( "%s", m_statisticsText.c_str() );
 		ImGui::InputInt( "FPS Limit", &m_params.fpsLimit, 1, 10 );
 		m_params.fpsLimit = std::max( m_params.fpsLimit, 0 );
 		ImGui::InputInt( "Fixed Updates Per Second", &m_params.fixedUpdatesPerSecond, 1, 10 );
 		m_params.fixedUpdatesPerSecond = Reflex::Clamp( m_params.fixedUpdatesPerSecond, 0, 240 );
 
-		ImGui::Text( Stream( "Mouse Pos: " << ImGui::GetMousePos().x << ", " << ImGui::GetMousePos().y ).c_str() );
+		ImGui::Text( "Mouse Pos: %g, %g", ImGui::GetMousePos().x, ImGui::GetMousePos().y );
 
 		ImGui::NewLine();
 
@@ -53,6 +53,18 @@ namespace Reflex::Core
 			sf::FloatRect worldBounds = sf::FloatRect( 0.0f, 0.0f, ( float )videoMode.width, ( float )videoMode.height );
 			sf::Vector2f gravity = sf::Vector2f( 0.0f, 9.8f );
 
+			// Component memory layout for the world (archetypes favour iterating many objects over adding / removing components)
+			World::StorageMode componentStorage = World::StorageMode::SparseSet;
+
+			// Order destroyed object indices are reused in (LIFO keeps memory warm, FIFO delays reuse of any one index)
+			World::IndexReuse objectIndexReuse = World::IndexReuse::LIFO;
+
+			// Back component chunks of at least the large page size with large pages (needs the "Lock pages in memory" privilege)
+			bool useLargePages = false;
+
+			// Memory resource backing the world's containers, must outlive the engine
+			std::pmr::memory_resource* worldMemoryResource = std::pmr::get_default_resource();
+
 			// Command Line Mode: Don't create a window - this is used for the unit tests project
 			bool cmdMode = false;
 		};
@@ -74,6 +86,7 @@ namespace Reflex::Core
 		void RegisterState( const bool isStartingState = false );
 
 		sf::RenderWindow& GetWindow() { return m_window; }
+		World& GetWorld() { return m_world; }
 
 	protected:
 		void Setup();
@@ -102,7 +115,7 @@ namespace Reflex::Core
 		StateManager m_stateManager;
 
 		// Stats
-		sf::String m_statisticsText;
+		std::string m_statisticsText;
 		sf::Time m_statisticsUpdateTime;
 		sf::Clock m_totalTime;
 
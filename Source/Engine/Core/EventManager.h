@@ -3,6 +3,7 @@
 #include "Events.h"
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <functional>
 #include "Utility.h"
@@ -12,6 +13,8 @@ namespace Reflex::Core
 	class EventManager
 	{
 	public:
+		explicit EventManager( std::pmr::memory_resource* resource = std::pmr::get_default_resource() ) : m_subscribers( resource ) { }
+
 		template < class EventType >
 		using callType = std::function< void( const EventType& ) >;
 
@@ -128,7 +131,8 @@ namespace Reflex::Core
 
 		unsigned nextTriggererIndex = 0;
 		unsigned nextReceiverIndex = 0;
-		std::vector< std::vector< ReceiverInstance > > m_subscribers;
+		// Inner lists are constructed with the outer list's resource
+		std::pmr::vector< std::pmr::vector< ReceiverInstance > > m_subscribers;
 	};
 
 	template< typename EventType, typename ReceiverType >
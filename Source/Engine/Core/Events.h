@@ -69,6 +69,14 @@ namespace Reflex::Core
 		{
 		}
 
+		// Moving keeps existing subscriptions pointed at the new triggerer
+		EventTriggerer( EventTriggerer&& other )
+			: triggererIndex( other.triggererIndex )
+			, eventManager( other.eventManager )
+		{
+			other.triggererIndex = std::nullopt;
+		}
+
 		template< typename EventType >
 		void Emit( const EventType& event );
 
@@ -0,0 +1,190 @@
+#include "Precompiled.h"
+#include "JobSystem.h"
+
+namespace Reflex::Core
+{
+	JobSystem& JobSystem::GetJobSystem()
+	{
+		// The main thread is the remaining hardware thread
+		static JobSystem jobSystem( std::max( std::thread::hardware_concurrency(), 1U ) - 1U );
+		return jobSystem;
+	}
+
+	JobSystem::JobSystem( const unsigned workerCount )
+	{
+		for( unsigned i = 0; i <= workerCount; ++i )
+			m_queues.push_back( std::make_unique< JobQueue >() );
+
+		m_workers.reserve( workerCount );
+
+		for( unsigned i = 0; i < workerCount; ++i )
+			m_workers.emplace_back( &JobSystem::WorkerLoop, this, i + 1 );
+
+		m_backgroundThread = std::thread( &JobSystem::BackgroundLoop, this );
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard< std::mutex > lock( m_sleepMutex );
+			m_shutdown = true;
+		}
+
+		m_wakeup.notify_all();
+
+		for( auto& worker : m_workers )
+			worker.join();
+
+		{
+			std::lock_guard< std::mutex > lock( m_backgroundMutex );
+			m_backgroundShutdown = true;
+		}
+
+		m_backgroundWakeup.notify_one();
+		m_backgroundThread.join();
+	}
+
+	void JobSystem::Run( std::function< void() > job, JobCounter& counter )
+	{
+		counter.m_pending.fetch_add( 1, std::memory_order_relaxed );
+
+		// Counted before it's queued so a thief can never take it before it's counted
+		m_queuedJobs.fetch_add( 1, std::memory_order_release );
+
+		{
+			auto& queue = *m_queues[s_queueIndex];
+			std::lock_guard< std::mutex > lock( queue.mutex );
+			queue.jobs.push_back( { std::move( job ), &counter } );
+		}
+
+		// Taking the sleep lock means a worker can't miss the wake up between checking for jobs and going to sleep
+		{
+			std::lock_guard< std::mutex > lock( m_sleepMutex );
+		}
+
+		m_wakeup.notify_one();
+	}
+
+	void JobSystem::RunBackground( std::function< void() > job, JobCounter& counter )
+	{
+		counter.m_pending.fetch_add( 1, std::memory_order_relaxed );
+
+		{
+			std::lock_guard< std::mutex > lock( m_backgroundMutex );
+			m_backgroundJobs.push_back( { std::move( job ), &counter } );
+		}
+
+		m_backgroundWakeup.notify_one();
+	}
+
+	void JobSystem::Wait( JobCounter& counter )
+	{
+		while( !counter.IsDone() )
+			if( !TryRunJob() )
+				std::this_thread::yield();
+
+		// Reset so the counter can be used again
+		if( counter.m_failed.exchange( false, std::memory_order_relaxed ) )
+			std::rethrow_exception( std::exchange( counter.m_exception, nullptr ) );
+	}
+
+	void JobSystem::RunJob( Job& job )
+	{
+		try
+		{
+			job.function();
+		}
+		catch( ... )
+		{
+			// Only the first is kept, the decrement below publishes it to Wait
+			if( !job.counter->m_failed.exchange( true, std::memory_order_relaxed ) )
+				job.counter->m_exception = std::current_exception();
+		}
+
+		job.counter->m_pending.fetch_sub( 1, std::memory_order_release );
+	}
+
+	bool JobSystem::TryRunJob()
+	{
+		Job job;
+
+		if( !PopJob( job ) )
+			return false;
+
+		RunJob( job );
+		return true;
+	}
+
+	bool JobSystem::PopJob( Job& job )
+	{
+		// Own queue first, newest job
+		{
+			auto& queue = *m_queues[s_queueIndex];
+			std::lock_guard< std::mutex > lock( queue.mutex );
+
+			if( !queue.jobs.empty() )
+			{
+				job = std::move( queue.jobs.back() );
+				queue.jobs.pop_back();
+				m_queuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+
+		// Then steal the oldest job from the other queues, starting from the next one along so thieves spread out
+		for( std::size_t i = 1; i < m_queues.size(); ++i )
+		{
+			auto& queue = *m_queues[( s_queueIndex + i ) % m_queues.size()];
+			std::lock_guard< std::mutex > lock( queue.mutex );
+
+			if( !queue.jobs.empty() )
+			{
+				job = std::move( queue.jobs.front() );
+				queue.jobs.pop_front();
+				m_queuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::WorkerLoop( const unsigned queueIndex )
+	{
+		s_queueIndex = queueIndex;
+
+		while( true )
+		{
+			if( TryRunJob() )
+				continue;
+
+			std::unique_lock< std::mutex > lock( m_sleepMutex );
+			m_wakeup.wait( lock, [this]() { return m_shutdown || m_queuedJobs.load( std::memory_order_acquire ) > 0; } );
+
+			if( m_shutdown )
+				return;
+		}
+	}
+
+	void JobSystem::BackgroundLoop()
+	{
+		// Exits once shut down and every queued job has run, so no counter is left waiting
+		while( true )
+		{
+			Job job;
+
+			{
+				std::unique_lock< std::mutex > lock( m_backgroundMutex );
+				m_backgroundWakeup.wait( lock, [this]() { return m_backgroundShutdown || !m_backgroundJobs.empty(); } );
+
+				if( m_backgroundJobs.empty() )
+					return;
+
+				job = std::move( m_backgroundJobs.front() );
+				m_backgroundJobs.pop_front();
+			}
+
+			RunJob( job );
+		}
+	}
+}
\ No newline at end of file
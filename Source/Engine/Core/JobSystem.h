@@ -0,0 +1,90 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+namespace Reflex::Core
+{
+	// Number of jobs still to finish, jobs started with the same counter can be waited on together
+	class JobCounter : sf::NonCopyable
+	{
+	public:
+		bool IsDone() const { return m_pending.load( std::memory_order_acquire ) == 0; }
+
+	private:
+		friend class JobSystem;
+		std::atomic< unsigned > m_pending = 0;
+
+		// The first exception thrown by one of the jobs, rethrown by Wait
+		std::atomic< bool > m_failed = false;
+		std::exception_ptr m_exception;
+	};
+
+	// Work stealing job system, one worker per hardware thread (less the main thread, which runs jobs while it waits on a counter)
+	// Every thread has its own deque of jobs, it pushes and pops its own jobs at the back (most recent first, while their data is still in cache)
+	// and when it runs out it steals the oldest job from the front of another thread's deque, so the threads rarely contend for the same lock
+	// Jobs must not touch anything another job running at the same time may be writing to
+	class JobSystem : sf::NonCopyable
+	{
+	public:
+		static JobSystem& GetJobSystem();
+		~JobSystem();
+
+		// Jobs started from within a job go on the running worker's own deque
+		void Run( std::function< void() > job, JobCounter& counter );
+
+		// Runs jobs on the calling thread until every job started with the counter has finished
+		// If any of them threw, the first exception is rethrown once they have all finished
+		void Wait( JobCounter& counter );
+
+		// Long running / blocking work (file loading, decoding), run one at a time on a separate background thread
+		// These are never picked up by the workers or by Wait, so they can't stall a frame's jobs
+		void RunBackground( std::function< void() > job, JobCounter& counter );
+
+		unsigned GetWorkerCount() const { return ( unsigned )m_workers.size(); }
+
+	protected:
+		explicit JobSystem( const unsigned workerCount );
+
+	private:
+		struct Job
+		{
+			std::function< void() > function;
+			JobCounter* counter = nullptr;
+		};
+
+		struct JobQueue
+		{
+			std::mutex mutex;
+			std::deque< Job > jobs;
+		};
+
+		// Runs the job and counts it as finished, even if it throws
+		static void RunJob( Job& job );
+		bool TryRunJob();
+		bool PopJob( Job& job );
+		void WorkerLoop( const unsigned queueIndex );
+		void BackgroundLoop();
+
+		// Queue 0 is shared by every thread which isn't a worker (the main thread), worker n owns queue n + 1
+		std::vector< std::unique_ptr< JobQueue > > m_queues;
+		std::vector< std::thread > m_workers;
+
+		// Idle workers sleep until a job is queued
+		std::atomic< unsigned > m_queuedJobs = 0;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeup;
+		bool m_shutdown = false;
+
+		std::thread m_backgroundThread;
+		std::mutex m_backgroundMutex;
+		std::condition_variable m_backgroundWakeup;
+		std::deque< Job > m_backgroundJobs;
+		bool m_backgroundShutdown = false;
+
+		static inline thread_local unsigned s_queueIndex = 0;
+	};
+}
\ No newline at end of file
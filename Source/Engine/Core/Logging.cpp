@@ -4,15 +4,14 @@
 namespace Reflex::Core
 {
 	// Static profiler
-	std::unique_ptr< Profiler > Profiler::s_profiler = nullptr;
 	bool Profiler::s_profilerEnabled = true;
 
 	// Function definitions
 	Profiler& Profiler::GetProfiler()
 	{
-		if( !s_profiler )
-			s_profiler = std::unique_ptr< Profiler >( new Profiler() );
-		return *s_profiler.get();
+		// Function local static so the first use from any thread constructs it safely
+		static Profiler profiler;
+		return profiler;
 	}
 
 	void Profiler::StartProfile( const std::string& name )
@@ -20,34 +19,30 @@ namespace Reflex::Core
 		if( !s_profilerEnabled )
 			return;
 
+		std::lock_guard< std::mutex > lock( m_mutex );
 		const auto found = m_profileData.find( name );
 
 		if( found == m_profileData.end() )
-		{
-			ProfileData data;
-			data.timer.restart();
-			m_profileData.insert( std::make_pair( name, data ) );
-		}
+			m_profileData.insert( std::make_pair( name, ProfileData() ) );
 		else
-		{
 			found->second.currentHitCount++;
-			found->second.timer.restart();
-		}
 	}
 
-	void Profiler::EndProfile( const std::string& name )
+	void Profiler::EndProfile( const std::string& name, const sf::Int64 durationMicroseconds )
 	{
 		if( !s_profilerEnabled )
 			return;
 
+		std::lock_guard< std::mutex > lock( m_mutex );
 		const auto found = m_profileData.find( name );
 		assert( found != m_profileData.end() );
-		const auto duration = found->second.timer.getElapsedTime().asMicroseconds();
-		found->second.currentFrame += duration;
+		found->second.currentFrame += durationMicroseconds;
 	}
 
 	void Profiler::FrameTick( const sf::Int64 frameTime )
 	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+
 		if( m_profileData.empty() || !s_profilerEnabled )
 			return;
 
@@ -72,6 +67,7 @@ namespace Reflex::Core
 		if( !s_profilerEnabled )
 			return;
 
+		std::lock_guard< std::mutex > lock( m_mutex );
 		std::ofstream stream( file );
 
 		stream << "********* ReflexEngine Performance Logging System **********\n\n";
@@ -103,6 +99,6 @@ namespace Reflex::Core
 
 	ScopedProfiler::~ScopedProfiler()
 	{
-		Profiler::GetProfiler().EndProfile( m_profileName );
+		Profiler::GetProfiler().EndProfile( m_profileName, m_timer.getElapsedTime().asMicroseconds() );
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../Memory/VectorMap.h"
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include "SFML/System/NonCopyable.hpp"
 #include "SFML/System/Clock.hpp"
 #include "OSUtility.h"
@@ -31,12 +32,13 @@ namespace Reflex
 	// Profiling code
 	namespace Core
 	{
+		// Safe to profile from multiple threads, each scope times itself and the results are added up under a lock
 		class Profiler : sf::NonCopyable
 		{
 		public:
 			static Profiler& GetProfiler();
 			void StartProfile( const std::string& name );
-			void EndProfile( const std::string& name );
+			void EndProfile( const std::string& name, const sf::Int64 durationMicroseconds );
 			void FrameTick( const sf::Int64 frameTimeMS );
 			void OutputResults( const std::string& file );
 
@@ -46,7 +48,6 @@ namespace Reflex
 		private:
 			struct ProfileData
 			{
-				sf::Clock timer;
 				sf::Int64 currentFrame = 0;
 				sf::Int64 shortestFrame = std::numeric_limits< int >::max();
 				sf::Int64 longestFrame = 0;
@@ -60,7 +61,7 @@ namespace Reflex
 			sf::Int64 m_totalDuration = 0;
 
 			Reflex::VectorMap< std::string, ProfileData > m_profileData;
-			static std::unique_ptr< Profiler > s_profiler;
+			std::mutex m_mutex;
 			static bool s_profilerEnabled;
 		};
 
@@ -72,6 +73,7 @@ namespace Reflex
 
 		private:
 			const std::string m_profileName;
+			sf::Clock m_timer;
 		};
 	}
 
@@ -23,4 +23,83 @@ namespace Reflex
 	private:
 		WORD savedAttributes = 0;
 	};
+
+	// Large page allocation needs the "Lock pages in memory" privilege, which has to be granted to the user and then enabled for the process
+	inline bool EnableLargePagePrivilege()
+	{
+		HANDLE token = nullptr;
+
+		if( !OpenProcessToken( GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token ) )
+			return false;
+
+		TOKEN_PRIVILEGES privileges = {};
+		privileges.PrivilegeCount = 1;
+		privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+		// AdjustTokenPrivileges succeeds even if the privilege wasn't granted, the last error says whether it was
+		const bool enabled = LookupPrivilegeValue( nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid )
+			&& AdjustTokenPrivileges( token, FALSE, &privileges, 0, nullptr, nullptr )
+			&& GetLastError() == ERROR_SUCCESS;
+
+		CloseHandle( token );
+		return enabled;
+	}
+
+	// Size must be a multiple of GetLargePageMinimum(), returns nullptr on failure
+	inline void* AllocateLargePages( const std::size_t bytes )
+	{
+		return VirtualAlloc( nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+	}
+
+	inline void FreeLargePages( void* ptr )
+	{
+		VirtualFree( ptr, 0, MEM_RELEASE );
+	}
+
+	// Read only view of a whole file, pages are only read in from disk as they are touched
+	class MappedFile
+	{
+	public:
+		explicit MappedFile( const std::string& path )
+		{
+			m_file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+
+			LARGE_INTEGER size = {};
+
+			// Empty files can't be mapped
+			if( m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx( m_file, &size ) || size.QuadPart == 0 )
+				return;
+
+			m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+			if( m_mapping )
+				m_data = static_cast< const char* >( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+
+			if( m_data )
+				m_size = ( std::size_t )size.QuadPart;
+		}
+
+		~MappedFile()
+		{
+			if( m_data )
+				UnmapViewOfFile( m_data );
+			if( m_mapping )
+				CloseHandle( m_mapping );
+			if( m_file != INVALID_HANDLE_VALUE )
+				CloseHandle( m_file );
+		}
+
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+
+		bool IsOpen() const { return m_data != nullptr; }
+		const char* GetData() const { return m_data; }
+		std::size_t GetSize() const { return m_size; }
+
+	private:
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "Precompiled.h"
+#include "Prefab.h"
+
+namespace Reflex::Core
+{
+	Prefab::~Prefab()
+	{
+		for( auto& component : m_components )
+		{
+			if( !component.prototype )
+				continue;
+
+			component.type->DestroyAt( component.prototype );
+			m_resource->deallocate( component.prototype, component.type->GetElementSize(), component.type->GetAlignment() );
+		}
+	}
+
+	void Prefab::AddPrototype( const ComponentFamily family, ComponentAllocatorBase& type, const void* source )
+	{
+		assert( type.IsCopyable() );
+		auto* prototype = m_resource->allocate( type.GetElementSize(), type.GetAlignment() );
+		type.CopyConstructAt( prototype, source );
+		m_components.push_back( { family, &type, prototype } );
+	}
+
+	void Prefab::AddValues( const ComponentFamily family, Values values )
+	{
+		m_components.push_back( { family, nullptr, nullptr, std::move( values ) } );
+	}
+
+	void Prefab::AddFields( const ComponentFamily family, std::vector< const FieldInfo* > fields, SnapshotWriter fieldData )
+	{
+		m_components.push_back( { family, nullptr, nullptr, {}, std::move( fields ), std::move( fieldData ) } );
+	}
+}
\ No newline at end of file
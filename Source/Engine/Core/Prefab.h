@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Memory/ComponentAllocator.h"
+#include "Core/Reflection.h"
+
+namespace Reflex::Core
+{
+	class World;
+
+	// Compiled form of a .ro object file, built once by World::GetPrefab and instanced with World::Instantiate
+	// Clonable components are stored as a constructed prototype which instances copy construct from, so instancing never touches json or strings
+	// Other reflected components keep the fields the file sets, already parsed, which instances read back in binary
+	// Anything else keeps its values (already read from the file) and has them applied through SetValue
+	class Prefab
+	{
+	public:
+		friend class World;
+
+		Prefab( const std::string& file, std::pmr::memory_resource* resource ) : m_file( file ), m_resource( resource ) { }
+		~Prefab();
+
+		Prefab( const Prefab& ) = delete;
+		Prefab& operator=( const Prefab& ) = delete;
+
+		const std::string& GetFile() const { return m_file; }
+		std::size_t GetComponentCount() const { return m_components.size(); }
+
+	private:
+		typedef std::vector< std::pair< std::string, std::string > > Values;
+
+		struct PrefabComponent
+		{
+			ComponentFamily family = 0;
+			ComponentAllocatorBase* type = nullptr;
+			void* prototype = nullptr;
+			Values values;
+
+			// Reflected fields set by the file, with their values in binary (see BaseComponent::WriteFields)
+			std::vector< const FieldInfo* > fields;
+			SnapshotWriter fieldData;
+		};
+
+		// Takes a copy of the source component as the family's prototype
+		void AddPrototype( const ComponentFamily family, ComponentAllocatorBase& type, const void* source );
+		void AddValues( const ComponentFamily family, Values values );
+		void AddFields( const ComponentFamily family, std::vector< const FieldInfo* > fields, SnapshotWriter fieldData );
+
+		std::string m_file;
+		std::pmr::memory_resource* m_resource = nullptr;
+
+		// Transform values from the file, which override the ones an instance is created with
+		std::optional< sf::Vector2f > m_position;
+		std::optional< float > m_rotation;
+		std::optional< sf::Vector2f > m_scale;
+		Values m_transformValues;
+
+		// In the order they appear in the file
+		std::vector< PrefabComponent > m_components;
+	};
+}
\ No newline at end of file
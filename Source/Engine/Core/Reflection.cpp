@@ -0,0 +1,48 @@
+#include "Precompiled.h"
+#include "Reflection.h"
+
+namespace Reflex::Core
+{
+	const FieldInfo* TypeInfo::FindField( const std::string_view name ) const
+	{
+		const auto found = std::find_if( m_fields.begin(), m_fields.end(), [&]( const FieldInfo& field ) { return field.name == name; } );
+		return found == m_fields.end() ? nullptr : &*found;
+	}
+
+	bool TypeInfo::SetValue( void* object, const std::string& name, const std::string& value ) const
+	{
+		const auto* field = FindField( name );
+
+		if( !field )
+			return false;
+
+		field->fromString( *field, object, value );
+		return true;
+	}
+
+	void TypeInfo::GetValues( const void* object, std::vector< std::pair< std::string, std::string > >& values ) const
+	{
+		for( const auto& field : m_fields )
+		{
+			if( field.saveIf && !field.saveIf( object ) )
+				continue;
+
+			if( field.omitDefault && field.isDefault( field, object ) )
+				continue;
+
+			values.emplace_back( field.name, field.toString( field, object ) );
+		}
+	}
+
+	void TypeInfo::WriteSnapshot( const void* object, SnapshotWriter& writer ) const
+	{
+		for( const auto& field : m_fields )
+			field.write( field, object, writer );
+	}
+
+	void TypeInfo::ReadSnapshot( void* object, SnapshotReader& reader ) const
+	{
+		for( const auto& field : m_fields )
+			field.read( field, object, reader );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Snapshot.h"
+
+namespace Reflex::Core
+{
+	enum class FieldType : std::uint8_t
+	{
+		Bool,
+		Int,
+		Unsigned,
+		Float,
+		Vector2f,
+		Vector2u,
+		Vector2i,
+		Colour,
+		String,
+		Flag,		// A single bit of a std::bitset member
+	};
+
+	template< typename T >
+	constexpr FieldType GetFieldType()
+	{
+		if constexpr( std::is_same_v< T, bool > ) return FieldType::Bool;
+		else if constexpr( std::is_same_v< T, int > ) return FieldType::Int;
+		else if constexpr( std::is_same_v< T, unsigned > ) return FieldType::Unsigned;
+		else if constexpr( std::is_same_v< T, float > ) return FieldType::Float;
+		else if constexpr( std::is_same_v< T, sf::Vector2f > ) return FieldType::Vector2f;
+		else if constexpr( std::is_same_v< T, sf::Vector2u > ) return FieldType::Vector2u;
+		else if constexpr( std::is_same_v< T, sf::Vector2i > ) return FieldType::Vector2i;
+		else if constexpr( std::is_same_v< T, sf::Color > ) return FieldType::Colour;
+		else if constexpr( std::is_same_v< T, std::string > ) return FieldType::String;
+		else static_assert( !sizeof( T ), "Unsupported reflected field type" );
+	}
+
+	// A single reflected member, accessed through a function generated from its member pointer (byte offsets aren't valid for types that aren't standard layout)
+	// The converters are generated per member type when the field is added, so no lookups are needed to read or write one
+	struct FieldInfo
+	{
+		using SavePredicate = bool( * )( const void* object );
+		using AddressFunc = void*( * )( void* object );
+
+		std::string_view name;
+		FieldType type = FieldType::Bool;
+		AddressFunc address = nullptr;
+		std::size_t size = 0;
+		std::size_t bit = 0;
+		bool omitDefault = false;
+		SavePredicate saveIf = nullptr;
+
+		void( *fromString )( const FieldInfo& field, void* object, const std::string& value ) = nullptr;
+		std::string( *toString )( const FieldInfo& field, const void* object ) = nullptr;
+		bool( *isDefault )( const FieldInfo& field, const void* object ) = nullptr;
+		void( *write )( const FieldInfo& field, const void* object, SnapshotWriter& writer ) = nullptr;
+		void( *read )( const FieldInfo& field, void* object, SnapshotReader& reader ) = nullptr;
+
+		void* GetAddress( void* object ) const { return address( object ); }
+		const void* GetAddress( const void* object ) const { return address( const_cast< void* >( object ) ); }
+
+		template< typename T >
+		T& Get( void* object ) const { return *static_cast< T* >( GetAddress( object ) ); }
+
+		template< typename T >
+		const T& Get( const void* object ) const { return *static_cast< const T* >( GetAddress( object ) ); }
+
+		// Only serialise the field when it isn't default (false / zero)
+		FieldInfo& OmitDefault() { omitDefault = true; return *this; }
+
+		// Only serialise the field when the predicate (given the owning object) returns true
+		FieldInfo& SaveIf( const SavePredicate predicate ) { saveIf = predicate; return *this; }
+	};
+
+	namespace Detail
+	{
+		template< typename Member >
+		struct MemberType;
+
+		template< typename Class, typename T >
+		struct MemberType< T Class::* > { using Type = T; };
+
+		// Object is the owning type, which may be derived from the class declaring the member
+		template< typename Owner, auto Member >
+		void* MemberAddress( void* object )
+		{
+			return &( static_cast< Owner* >( object )->*Member );
+		}
+
+		template< typename T >
+		struct FieldAccess
+		{
+			static void FromString( const FieldInfo& field, void* object, const std::string& value )
+			{
+				if constexpr( std::is_same_v< T, std::string > )
+					field.Get< T >( object ) = value;
+				else
+					field.Get< T >( object ) = Reflex::FromString< T >( value );
+			}
+
+			static std::string ToString( const FieldInfo& field, const void* object )
+			{
+				if constexpr( std::is_same_v< T, std::string > )
+					return field.Get< T >( object );
+				else
+					return Reflex::ToString( field.Get< T >( object ) );
+			}
+
+			static bool IsDefault( const FieldInfo& field, const void* object )
+			{
+				return Reflex::IsDefault( field.Get< T >( object ) );
+			}
+
+			static void Write( const FieldInfo& field, const void* object, SnapshotWriter& writer )
+			{
+				if constexpr( std::is_same_v< T, std::string > )
+					writer.WriteString( field.Get< T >( object ) );
+				else
+					writer.Write( field.Get< T >( object ) );
+			}
+
+			static void Read( const FieldInfo& field, void* object, SnapshotReader& reader )
+			{
+				if constexpr( std::is_same_v< T, std::string > )
+					field.Get< T >( object ) = reader.ReadString();
+				else
+					field.Get< T >( object ) = reader.Read< T >();
+			}
+		};
+
+		template< typename Bitset >
+		struct FlagAccess
+		{
+			static void FromString( const FieldInfo& field, void* object, const std::string& value )
+			{
+				field.Get< Bitset >( object ).set( field.bit, Reflex::FromString< bool >( value ) );
+			}
+
+			static std::string ToString( const FieldInfo& field, const void* object )
+			{
+				return Reflex::ToString( field.Get< Bitset >( object ).test( field.bit ) );
+			}
+
+			static bool IsDefault( const FieldInfo& field, const void* object )
+			{
+				return !field.Get< Bitset >( object ).test( field.bit );
+			}
+
+			static void Write( const FieldInfo& field, const void* object, SnapshotWriter& writer )
+			{
+				writer.Write( field.Get< Bitset >( object ).test( field.bit ) );
+			}
+
+			static void Read( const FieldInfo& field, void* object, SnapshotReader& reader )
+			{
+				field.Get< Bitset >( object ).set( field.bit, reader.Read< bool >() );
+			}
+		};
+	}
+
+	// Reflection table of a type, built once by the type's static Reflect function (see Component::GetTypeInfo)
+	// Object files, snapshots and editors read and write fields through this rather than each type's own string handling
+	class TypeInfo
+	{
+	public:
+		template< typename Owner, auto Member >
+		FieldInfo& AddField( const std::string_view name )
+		{
+			using T = typename Detail::MemberType< decltype( Member ) >::Type;
+			return AddField< Detail::FieldAccess< T > >( name, GetFieldType< T >(), &Detail::MemberAddress< Owner, Member >, sizeof( T ) );
+		}
+
+		template< typename Owner, auto Member >
+		FieldInfo& AddFlag( const std::string_view name, const std::size_t bit )
+		{
+			using Bitset = typename Detail::MemberType< decltype( Member ) >::Type;
+			assert( bit < Bitset().size() );
+			auto& field = AddField< Detail::FlagAccess< Bitset > >( name, FieldType::Flag, &Detail::MemberAddress< Owner, Member >, sizeof( Bitset ) );
+			field.bit = bit;
+			return field;
+		}
+
+		const FieldInfo* FindField( const std::string_view name ) const;
+		const std::vector< FieldInfo >& GetFields() const { return m_fields; }
+
+		// String round trip, only used for the json object files (and components saved without binary support)
+		bool SetValue( void* object, const std::string& name, const std::string& value ) const;
+		void GetValues( const void* object, std::vector< std::pair< std::string, std::string > >& values ) const;
+
+		// Every field is written / read directly in binary, in the order they were added
+		void WriteSnapshot( const void* object, SnapshotWriter& writer ) const;
+		void ReadSnapshot( void* object, SnapshotReader& reader ) const;
+
+	private:
+		template< typename Access >
+		FieldInfo& AddField( const std::string_view name, const FieldType type, const FieldInfo::AddressFunc address, const std::size_t size )
+		{
+			assert( !FindField( name ) );
+			auto& field = m_fields.emplace_back();
+			field.name = name;
+			field.type = type;
+			field.address = address;
+			field.size = size;
+			field.fromString = &Access::FromString;
+			field.toString = &Access::ToString;
+			field.isDefault = &Access::IsDefault;
+			field.write = &Access::Write;
+			field.read = &Access::Read;
+			return field;
+		}
+
+		std::vector< FieldInfo > m_fields;
+	};
+}
+
+// Helper macros used to build reflection tables, called on the TypeInfo passed to a type's Reflect function
+#define ReflectField( type, name, member ) \
+	AddField< type, &type::member >( name )
+
+#define ReflectFlag( type, name, member, bit ) \
+	AddFlag< type, &type::member >( name, bit )
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "Precompiled.h"
+#include "RegionStreamer.h"
+#include "World.h"
+#include "Snapshot.h"
+#include "Objects/Object.h"
+#include "Components/2D/TransformComponent.h"
+#include "Components/2D/CameraComponent.h"
+
+#include <filesystem>
+
+namespace Reflex::Core
+{
+	namespace
+	{
+		constexpr std::uint32_t RegionMagic = 0x47525852; // "RXRG"
+
+		float DistanceToBounds( const sf::Vector2f& position, const sf::FloatRect& bounds )
+		{
+			const auto x = std::max( { bounds.left - position.x, 0.0f, position.x - ( bounds.left + bounds.width ) } );
+			const auto y = std::max( { bounds.top - position.y, 0.0f, position.y - ( bounds.top + bounds.height ) } );
+			return std::sqrt( x * x + y * y );
+		}
+
+		// Runs on a background thread, a region that has never been saved reads back as empty
+		std::vector< char > ReadRegionFile( const std::string& path, const std::shared_future< bool > pendingSave )
+		{
+			if( pendingSave.valid() )
+				pendingSave.wait();
+
+			std::ifstream file( path, std::ios::binary | std::ios::ate );
+
+			if( !file )
+				return {};
+
+			std::vector< char > data( ( std::size_t )file.tellg() );
+			file.seekg( 0 );
+			file.read( data.data(), data.size() );
+			return data;
+		}
+	}
+
+	RegionStreamer::RegionStreamer( World& world )
+		: m_world( world )
+	{
+
+	}
+
+	RegionStreamer::~RegionStreamer()
+	{
+		// Nothing is inserted into a world being destroyed, the background work is just left to finish
+		for( auto& region : m_regions )
+			if( region.data.valid() )
+				region.data.wait();
+
+		for( auto& [index, save] : m_pendingSaves )
+			save.wait();
+	}
+
+	void RegionStreamer::Enable( const std::string& directory, const float loadDistance, const float unloadDistance )
+	{
+		assert( !directory.empty() && unloadDistance >= loadDistance );
+		m_directory = directory;
+		m_loadDistance = loadDistance;
+		m_unloadDistance = std::max( loadDistance, unloadDistance );
+
+		std::error_code error;
+		std::filesystem::create_directories( m_directory, error );
+
+		if( error )
+			LOG_CRIT( "Failed to create region directory: " << m_directory << " (" << error.message() << ")" );
+	}
+
+	void RegionStreamer::Disable()
+	{
+		// Loaded regions are unloaded, leaving their objects in the world would duplicate them when the regions are read again after enabling
+		Flush();
+
+		for( const auto& region : m_regions )
+			SaveRegion( region.index, true );
+
+		m_regions.clear();
+		Flush();
+		m_directory.clear();
+	}
+
+	void RegionStreamer::AddFocusPoint( const sf::Vector2f& position )
+	{
+		m_focusPoints.push_back( position );
+	}
+
+	void RegionStreamer::AddFocusObject( const BaseObject& object )
+	{
+		m_focusObjects.push_back( object );
+	}
+
+	void RegionStreamer::ClearFocus()
+	{
+		m_focusPoints.clear();
+		m_focusObjects.clear();
+	}
+
+	void RegionStreamer::LoadRegion( const sf::Vector2i& region )
+	{
+		assert( IsEnabled() );
+		RequestLoad( region, true );
+	}
+
+	void RegionStreamer::UnloadRegion( const sf::Vector2i& region )
+	{
+		auto found = FindRegion( region );
+
+		if( found == m_regions.end() )
+			return;
+
+		// Still being read, it has to be in the world before it can be written back out
+		if( found->state == RegionState::Loading )
+			InsertRegion( *found );
+
+		SaveRegion( region, true );
+		m_regions.erase( found );
+	}
+
+	void RegionStreamer::SaveAllRegions()
+	{
+		for( const auto& region : m_regions )
+			if( region.state == RegionState::Loaded )
+				SaveRegion( region.index, false );
+	}
+
+	bool RegionStreamer::IsRegionLoaded( const sf::Vector2i& region ) const
+	{
+		const auto found = FindRegion( region );
+		return found != m_regions.end() && found->state == RegionState::Loaded;
+	}
+
+	std::size_t RegionStreamer::GetLoadedRegionCount() const
+	{
+		return ( std::size_t )std::count_if( m_regions.begin(), m_regions.end(), []( const Region& region ) { return region.state == RegionState::Loaded; } );
+	}
+
+	std::size_t RegionStreamer::GetPendingRegionCount() const
+	{
+		return m_regions.size() - GetLoadedRegionCount();
+	}
+
+	sf::Vector2i RegionStreamer::GetRegion( const sf::Vector2f& position ) const
+	{
+		return m_world.GetTileMap().GetChunkIndex( position );
+	}
+
+	sf::FloatRect RegionStreamer::GetRegionBounds( const sf::Vector2i& region ) const
+	{
+		const auto size = ( float )m_world.GetTileMap().GetChunkSize();
+		return sf::FloatRect( region.x * size, region.y * size, size, size );
+	}
+
+	std::string RegionStreamer::GetRegionFile( const sf::Vector2i& region ) const
+	{
+		return Stream( m_directory << "/" << region.x << "_" << region.y << ".region" );
+	}
+
+	void RegionStreamer::Update()
+	{
+		if( !IsEnabled() )
+			return;
+
+		PROFILE;
+		RemoveFinishedSaves();
+
+		for( auto& region : m_regions )
+			if( region.state == RegionState::Loading && region.data.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+				InsertRegion( region );
+
+		std::vector< sf::Vector2f > focus;
+		GetFocusPositions( focus );
+
+		// Nothing to stream around, keep whatever is loaded rather than unloading everything
+		if( focus.empty() )
+			return;
+
+		for( const auto& position : focus )
+		{
+			const auto offset = sf::Vector2f( m_loadDistance, m_loadDistance );
+			const auto topLeft = GetRegion( position - offset );
+			const auto bottomRight = GetRegion( position + offset );
+
+			for( int x = topLeft.x; x <= bottomRight.x; ++x )
+				for( int y = topLeft.y; y <= bottomRight.y; ++y )
+					if( DistanceToBounds( position, GetRegionBounds( sf::Vector2i( x, y ) ) ) <= m_loadDistance )
+						RequestLoad( sf::Vector2i( x, y ), false );
+		}
+
+		std::vector< sf::Vector2i > outOfRange;
+
+		for( const auto& region : m_regions )
+		{
+			if( region.state != RegionState::Loaded || region.pinned )
+				continue;
+
+			const auto bounds = GetRegionBounds( region.index );
+
+			if( std::all_of( focus.begin(), focus.end(), [&]( const sf::Vector2f& position ) { return DistanceToBounds( position, bounds ) > m_unloadDistance; } ) )
+				outOfRange.push_back( region.index );
+		}
+
+		for( const auto& region : outOfRange )
+			UnloadRegion( region );
+	}
+
+	void RegionStreamer::Flush()
+	{
+		for( auto& region : m_regions )
+			if( region.state == RegionState::Loading )
+				InsertRegion( region );
+
+		for( auto& [index, save] : m_pendingSaves )
+			save.wait();
+
+		RemoveFinishedSaves();
+	}
+
+	std::vector< RegionStreamer::Region >::iterator RegionStreamer::FindRegion( const sf::Vector2i& region )
+	{
+		return std::find_if( m_regions.begin(), m_regions.end(), [&]( const Region& other ) { return other.index == region; } );
+	}
+
+	std::vector< RegionStreamer::Region >::const_iterator RegionStreamer::FindRegion( const sf::Vector2i& region ) const
+	{
+		return std::find_if( m_regions.begin(), m_regions.end(), [&]( const Region& other ) { return other.index == region; } );
+	}
+
+	void RegionStreamer::GetFocusPositions( std::vector< sf::Vector2f >& out ) const
+	{
+		out = m_focusPoints;
+
+		if( const auto camera = m_world.GetActiveCamera() )
+			out.push_back( camera->getCenter() );
+
+		for( const auto& object : m_focusObjects )
+			if( m_world.IsValidObject( object ) )
+				out.push_back( Object( object ).GetTransform()->GetWorldPosition() );
+	}
+
+	void RegionStreamer::RequestLoad( const sf::Vector2i& region, const bool pinned )
+	{
+		const auto found = FindRegion( region );
+
+		if( found != m_regions.end() )
+		{
+			found->pinned = found->pinned || pinned;
+			return;
+		}
+
+		// If the region is still being written out, the read waits for the latest write to finish
+		std::shared_future< bool > pendingSave;
+
+		for( const auto& [index, save] : m_pendingSaves )
+			if( index == region )
+				pendingSave = save;
+
+		auto& newRegion = m_regions.emplace_back();
+		newRegion.index = region;
+		newRegion.pinned = pinned;
+		newRegion.data = std::async( std::launch::async, ReadRegionFile, GetRegionFile( region ), pendingSave );
+	}
+
+	void RegionStreamer::InsertRegion( Region& region )
+	{
+		PROFILE;
+		region.state = RegionState::Loaded;
+
+		// A bad file is reported and the region left empty, rather than taking down the update (ReadObjects leaves the world untouched when it throws)
+		try
+		{
+			const auto data = region.data.get();
+
+			if( data.empty() )
+				return;
+
+			SnapshotReader reader( data.data(), data.size() );
+			const auto magic = reader.Read< std::uint32_t >();
+			const auto version = reader.Read< std::uint32_t >();
+
+			if( magic != RegionMagic || version != SnapshotVersion )
+			{
+				LOG_CRIT( "Invalid region file: " << GetRegionFile( region.index ) << " (version " << version << ", expected " << SnapshotVersion << ")" );
+				return;
+			}
+
+			std::vector< Object > objects;
+			m_world.ReadObjects( reader, objects );
+		}
+		catch( const std::exception& e )
+		{
+			LOG_CRIT( "Invalid region file: " << GetRegionFile( region.index ) << " (" << e.what() << ")" );
+		}
+	}
+
+	void RegionStreamer::SaveRegion( const sf::Vector2i& region, const bool destroyObjects )
+	{
+		PROFILE;
+
+		// The active camera and focus objects always stay resident, wherever they are
+		const auto camera = m_world.GetActiveCamera();
+		const auto sceneRoot = m_world.GetSceneRoot();
+		std::vector< Object > roots;
+
+		for( unsigned i = 0; i < sceneRoot->GetChildrenCount(); ++i )
+		{
+			const auto child = sceneRoot->GetChild( i );
+
+			if( GetRegion( child.GetTransform()->GetWorldPosition() ) != region )
+				continue;
+
+			if( ( camera && camera->GetObject() == child ) || std::find( m_focusObjects.begin(), m_focusObjects.end(), child ) != m_focusObjects.end() )
+				continue;
+
+			roots.push_back( child );
+		}
+
+		SnapshotWriter writer;
+		writer.Write( RegionMagic );
+		writer.Write( SnapshotVersion );
+		const auto objects = m_world.WriteObjects( roots, writer );
+
+		// Children first, so each one detaches from a parent that still exists
+		if( destroyObjects )
+			for( auto object = objects.rbegin(); object != objects.rend(); ++object )
+				m_world.DestroyObject( *object );
+
+		m_pendingSaves.emplace_back( region, std::async( std::launch::async, [writer = std::move( writer ), path = GetRegionFile( region )]()
+		{
+			return writer.SaveToFile( path );
+		} ).share() );
+	}
+
+	void RegionStreamer::RemoveFinishedSaves()
+	{
+		for( auto save = m_pendingSaves.begin(); save != m_pendingSaves.end(); )
+		{
+			if( save->second.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+			{
+				++save;
+				continue;
+			}
+
+			if( !save->second.get() )
+				LOG_CRIT( "Failed to write region file: " << GetRegionFile( save->first ) );
+
+			save = m_pendingSaves.erase( save );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Objects/BaseObject.h"
+
+#include <future>
+
+namespace Reflex { class Object; }
+
+namespace Reflex::Core
+{
+	class World;
+
+	// Partitions the world into regions aligned to the tile map's chunks, each region's objects are stored in their own file
+	// Regions near the active camera / focus points are read on a background thread and inserted in bulk at the world's update sync point
+	// Regions that fall out of range are written out (also on a background thread) and their objects destroyed
+	// Only objects attached to the scene root are assigned to a region (by position), their children go with them
+	class RegionStreamer : sf::NonCopyable
+	{
+	public:
+		explicit RegionStreamer( World& world );
+		~RegionStreamer();
+
+		// Streaming starts once a directory is set, regions are loaded within loadDistance of a focus and unloaded past unloadDistance
+		// Disabling unloads every loaded region (writing it out and destroying its objects)
+		void Enable( const std::string& directory, const float loadDistance, const float unloadDistance );
+		void Disable();
+		bool IsEnabled() const { return !m_directory.empty(); }
+
+		// The active camera is always a focus, these add to it
+		void AddFocusPoint( const sf::Vector2f& position );
+		void AddFocusObject( const BaseObject& object );
+		void ClearFocus();
+
+		// Explicitly loaded regions stay loaded until explicitly unloaded
+		void LoadRegion( const sf::Vector2i& region );
+		void UnloadRegion( const sf::Vector2i& region );
+
+		// Writes out every loaded region, keeping the objects in the world
+		void SaveAllRegions();
+
+		bool IsRegionLoaded( const sf::Vector2i& region ) const;
+		std::size_t GetLoadedRegionCount() const;
+		std::size_t GetPendingRegionCount() const;
+
+		sf::Vector2i GetRegion( const sf::Vector2f& position ) const;
+		sf::FloatRect GetRegionBounds( const sf::Vector2i& region ) const;
+		std::string GetRegionFile( const sf::Vector2i& region ) const;
+
+		// Called by the world at its update sync point
+		void Update();
+
+		// Blocks until every region being read / written in the background has finished (reads are inserted into the world)
+		void Flush();
+
+	private:
+		enum class RegionState
+		{
+			Loading,
+			Loaded,
+		};
+
+		struct Region
+		{
+			sf::Vector2i index;
+			RegionState state = RegionState::Loading;
+			bool pinned = false;
+			std::future< std::vector< char > > data;
+		};
+
+		std::vector< Region >::iterator FindRegion( const sf::Vector2i& region );
+		std::vector< Region >::const_iterator FindRegion( const sf::Vector2i& region ) const;
+
+		void GetFocusPositions( std::vector< sf::Vector2f >& out ) const;
+		void RequestLoad( const sf::Vector2i& region, const bool pinned );
+		void InsertRegion( Region& region );
+		void SaveRegion( const sf::Vector2i& region, const bool destroyObjects );
+		void RemoveFinishedSaves();
+
+		World& m_world;
+		std::string m_directory;
+		float m_loadDistance = 0.0f;
+		float m_unloadDistance = 0.0f;
+
+		std::vector< sf::Vector2f > m_focusPoints;
+		std::vector< BaseObject > m_focusObjects;
+		std::vector< Region > m_regions;
+
+		// Writes still in flight, a region being written is only read back once its write has finished
+		std::vector< std::pair< sf::Vector2i, std::shared_future< bool > > > m_pendingSaves;
+	};
+}
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <map>
+#include <future>
 
 #include "Utility.h"
 #include "Logging.h"
+#include "JobSystem.h"
 
 #include "SFML/Graphics/Font.hpp"
+#include "SFML/Graphics/Image.hpp"
 #include "SFML/Graphics/Texture.hpp"
 
 namespace Reflex
@@ -20,10 +23,32 @@ namespace Reflex
 		typedef ResouceManager< sf::Texture > TextureManager;
 		typedef ResouceManager< sf::Font > FontManager;
 
+		// How a resource is loaded asynchronously, Decode runs on a worker thread and Upload on the main thread (see ResouceManager::Update)
+		// By default the whole resource is loaded on the worker, then copied into place
+		template< typename Resource >
+		struct ResourceDecoder
+		{
+			typedef Resource Decoded;
+			static bool Decode( const std::string& filename, Decoded& out ) { return out.loadFromFile( filename ); }
+			static bool Upload( Resource& resource, Decoded& decoded ) { resource = decoded; return true; }
+		};
+
+		// Textures are decoded into an image on the worker, only the GPU upload happens on the main thread
+		template<>
+		struct ResourceDecoder< sf::Texture >
+		{
+			typedef sf::Image Decoded;
+			static bool Decode( const std::string& filename, Decoded& out ) { return out.loadFromFile( filename ); }
+			static bool Upload( sf::Texture& resource, Decoded& decoded ) { return resource.loadFromImage( decoded ); }
+		};
+
 		template< typename Resource >
 		class ResouceManager
 		{
 		public:
+			ResouceManager() = default;
+			~ResouceManager();
+
 			// Resource loading
 			Resource& LoadResource( const ResourceID id, const std::string& filename );
 
@@ -31,21 +56,73 @@ namespace Reflex
 			template< typename Parameter >
 			Resource& LoadResource( const ResourceID id, const std::string& filename, const Parameter& secondParam );
 
+			// Decodes the file on a worker thread, the resource is usable straight away (as a copy of the placeholder if one is set)
+			// and is loaded in place by Update once decoding finishes, so references taken before then stay valid
+			// Requests for a file that is already loading / loaded share it, the future is true once it's loaded (false if it failed)
+			std::shared_future< bool > LoadResourceAsync( const ResourceID id, const std::string& filename );
+
+			// Contents given to asynchronously loaded resources until they finish (and kept if they fail to load)
+			Resource& LoadPlaceholder( const std::string& filename );
+
+			// Finishes any asynchronous loads that have decoded, must be called from the main thread (the engine calls this every frame)
+			void Update();
+
+			// Blocks until every asynchronous load has finished, then finishes them on the calling thread
+			void WaitForAll();
+
+			std::size_t GetPendingCount() const { return m_pending.size(); }
+
 			// Fetches a resource from the map
 			const Resource& GetResource( const ResourceID id ) const;
 
 		private:
 			// Private helper function to insert a new resource into the map and do error checking
-			Resource& InsertResource( const ResourceID id, const std::string& filename, std::unique_ptr< Resource > newResource );
+			Resource& InsertResource( const ResourceID id, const std::string& filename, std::shared_ptr< Resource > newResource );
+
+			struct PendingLoad
+			{
+				std::string filename;
+				std::shared_ptr< Resource > resource;
+				typename ResourceDecoder< Resource >::Decoded decoded;
+				bool decodeSucceeded = false;
+				JobCounter counter;
+				std::promise< bool > promise;
+				std::shared_future< bool > future;
+			};
 
-			std::map< const ResourceID, std::unique_ptr< Resource > > m_resourceMap;
+			void FinishLoad( PendingLoad& pending );
+
+			std::map< const ResourceID, std::shared_ptr< Resource > > m_resourceMap;
+
+			// Every file loaded / loading, so requests for the same file share one resource
+			std::map< std::string, std::shared_ptr< Resource > > m_fileMap;
+
+			std::vector< std::unique_ptr< PendingLoad > > m_pending;
+			std::unique_ptr< Resource > m_placeholder;
 		};
 
 		// Template functions
+		template< typename Resource >
+		ResouceManager< Resource >::~ResouceManager()
+		{
+			// The decode jobs write into their pending load, so they have to finish before it's freed
+			for( auto& pending : m_pending )
+			{
+				// A decode that threw has nothing left to report to
+				try
+				{
+					JobSystem::GetJobSystem().Wait( pending->counter );
+				}
+				catch( ... )
+				{
+				}
+			}
+		}
+
 		template< typename Resource >
 		Resource& ResouceManager< Resource >::LoadResource( const ResourceID id, const std::string& filename )
 		{
-			auto newResource = std::make_unique< Resource >();
+			auto newResource = std::make_shared< Resource >();
 
 			if( !newResource->loadFromFile( filename ) )
 				THROW( "Failed to load " << filename );
@@ -57,7 +134,7 @@ namespace Reflex
 		template< typename Parameter >
 		Resource& ResouceManager< Resource >::LoadResource( const ResourceID id, const std::string& filename, const Parameter& secondParam )
 		{
-			auto newResource = std::make_unique< Resource >();
+			auto newResource = std::make_shared< Resource >();
 
 			if( !newResource->loadFromFile( filename, secondParam ) )
 				THROW( "Failed to load " << filename );
@@ -65,20 +142,117 @@ namespace Reflex
 			return InsertResource( id, filename, std::move( newResource ) );
 		}
 
+		template< typename Resource >
+		std::shared_future< bool > ResouceManager< Resource >::LoadResourceAsync( const ResourceID id, const std::string& filename )
+		{
+			const auto pending = std::find_if( m_pending.begin(), m_pending.end(), [&]( const auto& load ) { return load->filename == filename; } );
+
+			if( pending != m_pending.end() )
+			{
+				m_resourceMap[id] = ( *pending )->resource;
+				return ( *pending )->future;
+			}
+
+			const auto loaded = m_fileMap.find( filename );
+
+			if( loaded != m_fileMap.end() )
+			{
+				m_resourceMap[id] = loaded->second;
+				std::promise< bool > promise;
+				promise.set_value( true );
+				return promise.get_future().share();
+			}
+
+			auto& load = *m_pending.emplace_back( std::make_unique< PendingLoad >() );
+			load.filename = filename;
+			load.resource = m_placeholder ? std::make_shared< Resource >( *m_placeholder ) : std::make_shared< Resource >();
+			load.future = load.promise.get_future().share();
+			m_resourceMap[id] = load.resource;
+			m_fileMap[filename] = load.resource;
+
+			// On the background thread, so a frame waiting on its own jobs never ends up decoding a file
+			JobSystem::GetJobSystem().RunBackground( [&load]()
+			{
+				load.decodeSucceeded = ResourceDecoder< Resource >::Decode( load.filename, load.decoded );
+			}, load.counter );
+
+			return load.future;
+		}
+
+		template< typename Resource >
+		Resource& ResouceManager< Resource >::LoadPlaceholder( const std::string& filename )
+		{
+			m_placeholder = std::make_unique< Resource >();
+
+			if( !m_placeholder->loadFromFile( filename ) )
+				THROW( "Failed to load " << filename );
+
+			return *m_placeholder;
+		}
+
+		template< typename Resource >
+		void ResouceManager< Resource >::Update()
+		{
+			for( auto pending = m_pending.begin(); pending != m_pending.end(); )
+			{
+				if( !( *pending )->counter.IsDone() )
+				{
+					++pending;
+					continue;
+				}
+
+				FinishLoad( **pending );
+				pending = m_pending.erase( pending );
+			}
+		}
+
+		template< typename Resource >
+		void ResouceManager< Resource >::WaitForAll()
+		{
+			for( auto& pending : m_pending )
+			{
+				JobSystem::GetJobSystem().Wait( pending->counter );
+				FinishLoad( *pending );
+			}
+
+			m_pending.clear();
+		}
+
+		template< typename Resource >
+		void ResouceManager< Resource >::FinishLoad( PendingLoad& pending )
+		{
+			const auto succeeded = pending.decodeSucceeded && ResourceDecoder< Resource >::Upload( *pending.resource, pending.decoded );
+
+			// Unlike LoadResource this doesn't throw, the resource keeps the placeholder's contents
+			if( !succeeded )
+			{
+				LOG_CRIT( "Failed to load " << pending.filename );
+				m_fileMap.erase( pending.filename );
+			}
+
+			pending.promise.set_value( succeeded );
+		}
+
 		template< typename Resource >
 		const Resource& ResouceManager< Resource >::GetResource( const ResourceID id ) const
 		{
 			auto found = m_resourceMap.find( id );
 
 			if( found == m_resourceMap.end() )
+			{
 				LOG_CRIT( "Resource doesn't exist " << ( int )id );
 
+				if( m_placeholder )
+					return *m_placeholder;
+			}
+
 			return *found->second;
 		}
 
 		template< typename Resource >
-		Resource& ResouceManager< Resource >::InsertResource( const ResourceID id, const std::string& filename, std::unique_ptr< Resource > newResource )
+		Resource& ResouceManager< Resource >::InsertResource( const ResourceID id, const std::string& filename, std::shared_ptr< Resource > newResource )
 		{
+			m_fileMap[filename] = newResource;
 			auto inserted = m_resourceMap.insert( std::make_pair( id, std::move( newResource ) ) );
 
 			//if( !inserted.second )
@@ -88,4 +262,4 @@ namespace Reflex
 			return *resource_iter.second;
 		}
 	}
-}
+}
\ No newline at end of file
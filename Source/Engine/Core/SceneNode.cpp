@@ -8,7 +8,7 @@ namespace Reflex::Core
 	SceneNode::SceneNode( const Reflex::Object& owner )
 		: m_owningObject( owner )
 		, m_parent()
-		, m_children()
+		, m_children( owner.GetWorld().GetMemoryResource() )
 	{
 
 	}
@@ -16,11 +16,26 @@ namespace Reflex::Core
 	SceneNode::SceneNode( const SceneNode& other )
 		: m_owningObject( other.m_owningObject )
 		, m_parent( other.m_parent )
-		, m_children( other.m_children )
+		, m_children( other.m_children, other.m_children.get_allocator() )
+		, m_worldTransformDirty( true )
 	{
 
 	}
 
+	SceneNode::SceneNode( SceneNode&& other )
+		: sf::Transformable( other )
+		, m_owningObject( other.m_owningObject )
+		, m_parent( other.m_parent )
+		, m_children( std::move( other.m_children ) )
+		, m_worldTransform( other.m_worldTransform )
+		, m_worldTransformDirty( other.m_worldTransformDirty.load( std::memory_order_relaxed ) )
+	{
+		// The cache moves with the node, forcing it dirty here would leave clean children under a dirty parent (so they'd never be invalidated)
+		// Parent / children reference objects not addresses, so the moved from node just needs to forget them (so it doesn't detach on destruction)
+		other.m_parent = Reflex::Object();
+		other.m_children.clear();
+	}
+
 	SceneNode::~SceneNode()
 	{
 		if( m_parent )
@@ -35,6 +50,7 @@ namespace Reflex::Core
 			transform->m_parent.GetTransform()->DetachChild( child );
 
 		transform->m_parent = GetObject();
+		transform->InvalidateWorldTransform();
 		transform->IncrementZOrder();
 		transform->SetLayer( GetObject().GetTransform()->GetLayer() + 1 );
 		m_children.push_back( child );
@@ -49,7 +65,10 @@ namespace Reflex::Core
 			{
 				if( m_children[i] )
 					if( const auto transform = m_children[i].GetTransform() )
+					{
 						transform->m_parent = Reflex::Object();
+						transform->InvalidateWorldTransform();
+					}
 
 				m_children.erase( m_children.begin() + i );
 				return node;
@@ -62,13 +81,23 @@ namespace Reflex::Core
 
 	sf::Transform SceneNode::GetWorldTransform() const
 	{
-		TODO( "Cache the world transform" );
-		sf::Transform worldTransform;
+		if( m_worldTransformDirty.load( std::memory_order_relaxed ) )
+		{
+			m_worldTransform = m_parent ? m_parent.GetTransform()->GetWorldTransform() * getTransform() : getTransform();
+			m_worldTransformDirty.store( false, std::memory_order_relaxed );
+		}
 
-		for( auto node = GetObject(); node.IsValid(); node = node.GetTransform()->m_parent )
-			worldTransform = node.GetTransform()->getTransform() * worldTransform;
+		return m_worldTransform;
+	}
+
+	void SceneNode::InvalidateWorldTransform()
+	{
+		if( m_worldTransformDirty.exchange( true, std::memory_order_relaxed ) )
+			return;
 
-		return worldTransform;
+		for( const auto& child : m_children )
+			if( const auto transform = child.GetTransform() )
+				transform->InvalidateWorldTransform();
 	}
 
 	sf::Vector2f SceneNode::GetWorldPosition() const
@@ -5,11 +5,16 @@
 
 namespace Reflex::Core
 {
+	class World;
+
 	class SceneNode : public sf::Transformable
 	{
 	public:
+		friend class World;
+
 		SceneNode( const Reflex::Object& owner );
 		SceneNode( const SceneNode& other );
+		SceneNode( SceneNode&& other );
 		~SceneNode();
 
 		void AttachChild( const Reflex::Object& child );
@@ -34,8 +39,16 @@ namespace Reflex::Core
 		Reflex::Object GetObject() const;
 
 	protected:
+		// Marks the cached world transform of this node and all of its descendants out of date, must be called whenever the local transform changes
+		void InvalidateWorldTransform();
+
 		Reflex::Object m_owningObject;
 		Reflex::Object m_parent;
-		std::vector< Reflex::Object > m_children;
+		std::pmr::vector< Reflex::Object > m_children;
+
+		// Computed on demand by GetWorldTransform, a node is only dirty if all of its descendants are as well (so invalidating can stop at the first dirty node)
+		// Like sf::Transformable's own transform it is updated lazily, so a dirty node mustn't be read from multiple threads at once
+		mutable sf::Transform m_worldTransform;
+		mutable std::atomic< bool > m_worldTransformDirty{ true };
 	};
 }
\ No newline at end of file
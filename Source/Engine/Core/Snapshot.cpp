@@ -0,0 +1,51 @@
+#include "Precompiled.h"
+#include "Snapshot.h"
+#include "Logging.h"
+
+#include <filesystem>
+
+namespace Reflex::Core
+{
+	bool SnapshotWriter::SaveToFile( const std::string& path ) const
+	{
+		// Written to a temporary file which then replaces the target, so an interrupted save never leaves a partly written file behind
+		const auto temporary = path + ".tmp";
+		std::error_code error;
+
+		{
+			std::ofstream output( temporary, std::ios::binary | std::ios::trunc );
+
+			if( output.fail() )
+				return false;
+
+			output.write( m_buffer.data(), ( std::streamsize )m_buffer.size() );
+			output.close();
+
+			if( output.fail() )
+			{
+				std::filesystem::remove( temporary, error );
+				return false;
+			}
+		}
+
+		std::filesystem::rename( temporary, path, error );
+
+		if( error )
+		{
+			std::filesystem::remove( temporary, error );
+			return false;
+		}
+
+		return true;
+	}
+
+	const char* SnapshotReader::ReadBytes( const std::size_t bytes )
+	{
+		if( bytes > m_size - m_offset )
+			THROW( "Snapshot data is truncated (reading " << bytes << " bytes at offset " << m_offset << " of " << m_size << ")" );
+
+		const auto* data = m_data + m_offset;
+		m_offset += bytes;
+		return data;
+	}
+}
\ No newline at end of file
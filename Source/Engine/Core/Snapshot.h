@@ -0,0 +1,105 @@
+#pragma once
+
+namespace Reflex::Core
+{
+	// Binary world snapshots (see World::SaveSnapshot / World::LoadSnapshot)
+	// Everything is written in native layout and endianness, so a snapshot is only meant to be loaded by the same build on the same platform
+	constexpr std::uint32_t SnapshotMagic = 0x4E535852; // "RXSN"
+	constexpr std::uint32_t SnapshotVersion = 3;
+
+	// Appends values to a single growing buffer, which is written to disk with one sequential write
+	class SnapshotWriter
+	{
+	public:
+		explicit SnapshotWriter( const std::size_t reserveBytes = 0 ) { m_buffer.reserve( reserveBytes ); }
+
+		template< typename T >
+		void Write( const T& value )
+		{
+			static_assert( std::is_trivially_copyable_v< T >, "Only trivially copyable values can be written directly" );
+			WriteBytes( &value, sizeof( T ) );
+		}
+
+		template< typename T >
+		void WriteArray( const T* values, const std::size_t count )
+		{
+			static_assert( std::is_trivially_copyable_v< T >, "Only trivially copyable values can be written directly" );
+			Write( ( std::uint32_t )count );
+			WriteBytes( values, sizeof( T ) * count );
+		}
+
+		void WriteString( const std::string& value )
+		{
+			WriteArray( value.data(), value.size() );
+		}
+
+		void WriteBytes( const void* data, const std::size_t bytes )
+		{
+			if( bytes == 0 )
+				return;
+
+			const auto offset = m_buffer.size();
+			m_buffer.resize( offset + bytes );
+			std::memcpy( m_buffer.data() + offset, data, bytes );
+		}
+
+		// Overwrites a value written earlier (eg. a size that is only known once what follows it has been written)
+		template< typename T >
+		void WriteAt( const std::size_t offset, const T& value )
+		{
+			static_assert( std::is_trivially_copyable_v< T >, "Only trivially copyable values can be written directly" );
+			assert( offset + sizeof( T ) <= m_buffer.size() );
+			std::memcpy( m_buffer.data() + offset, &value, sizeof( T ) );
+		}
+
+		const char* GetData() const { return m_buffer.data(); }
+		std::size_t GetSize() const { return m_buffer.size(); }
+		bool SaveToFile( const std::string& path ) const;
+
+	private:
+		std::vector< char > m_buffer;
+	};
+
+	// Reads values back out of a snapshot in memory (usually a mapped file), throws if it reads past the end
+	class SnapshotReader
+	{
+	public:
+		SnapshotReader( const char* data, const std::size_t size ) : m_data( data ), m_size( size ) { }
+
+		template< typename T >
+		T Read()
+		{
+			static_assert( std::is_trivially_copyable_v< T >, "Only trivially copyable values can be read directly" );
+			T value;
+			std::memcpy( &value, ReadBytes( sizeof( T ) ), sizeof( T ) );
+			return value;
+		}
+
+		template< typename T >
+		void ReadArray( std::vector< T >& out )
+		{
+			static_assert( std::is_trivially_copyable_v< T >, "Only trivially copyable values can be read directly" );
+			const auto count = Read< std::uint32_t >();
+			const auto* data = ReadBytes( sizeof( T ) * count );
+			out.resize( count );
+
+			if( count )
+				std::memcpy( out.data(), data, sizeof( T ) * count );
+		}
+
+		std::string ReadString()
+		{
+			const auto count = Read< std::uint32_t >();
+			return std::string( ReadBytes( count ), count );
+		}
+
+		const char* ReadBytes( const std::size_t bytes );
+
+		std::size_t GetRemaining() const { return m_size - m_offset; }
+
+	private:
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+		std::size_t m_offset = 0;
+	};
+}
\ No newline at end of file
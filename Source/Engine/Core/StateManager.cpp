@@ -69,7 +69,13 @@ namespace Reflex::Core
 			}
 		}
 
+		// Leaving a state usually destroys a lot of objects (eg. unloading a level), a good time to give the memory back
+		const auto removedStates = std::any_of( m_pendingList.begin(), m_pendingList.end(), []( const auto& change ) { return change.second != Action::Push; } );
+
 		m_pendingList.clear();
+
+		if( removedStates )
+			m_world.Compact( true );
 	}
 
 	std::unique_ptr< State > StateManager::CreateState( const Type stateType )
@@ -8,9 +8,11 @@
 
 namespace Reflex::Core
 {
-	TileMap::TileMap( const unsigned cellSize, const unsigned chunkSizeInCells )
+	TileMap::TileMap( const unsigned cellSize, const unsigned chunkSizeInCells, std::pmr::memory_resource* resource )
 		: m_cellSize( cellSize )
 		, m_chunkSizeInCells( chunkSizeInCells )
+		, m_memoryResource( resource )
+		, m_spacialChunks( resource )
 	{
 		Reset();
 	}
@@ -27,10 +29,10 @@ namespace Reflex::Core
 		m_chunkSize = m_cellSize * m_chunkSizeInCells;
 		m_spacialChunks.clear();
 
-		Chunk newChunk;
+		Chunk newChunk( m_memoryResource );
 		newChunk.chunk = sf::Vector2i( 0, 0 );
 		newChunk.buckets.resize( m_chunkSizeInCells * m_chunkSizeInCells );
-		m_spacialChunks.push_back( newChunk );
+		m_spacialChunks.push_back( std::move( newChunk ) );
 	}
 
 	void TileMap::Repopulate( World& world, const unsigned cellSize, const unsigned chunkSizeInCells )
@@ -59,7 +61,7 @@ namespace Reflex::Core
 			auto chunk_iter = FindChunk( chunkIdx );
 			if( chunk_iter == m_spacialChunks.end() )
 			{
-				m_spacialChunks.emplace_back();
+				m_spacialChunks.emplace_back( m_memoryResource );
 				chunk_iter = std::prev( m_spacialChunks.end() );
 			}
 
@@ -88,8 +90,6 @@ namespace Reflex::Core
 		{
 			const auto locTopLeft = CellHash( sf::Vector2f( boundary.left, boundary.top ) );
 			const auto locBotRight = CellHash( sf::Vector2f( boundary.left + boundary.width, boundary.top + boundary.height ) );
-			std::vector< unsigned > ids;
-
 			for( int x = locTopLeft.x; x <= locBotRight.x; ++x )
 			{
 				for( int y = locTopLeft.y; y <= locBotRight.y; ++y )
@@ -99,7 +99,7 @@ namespace Reflex::Core
 					auto chunk_iter = FindChunk( chunkIdx );
 					if( chunk_iter == m_spacialChunks.end() )
 					{
-						m_spacialChunks.emplace_back();
+						m_spacialChunks.emplace_back( m_memoryResource );
 						chunk_iter = std::prev( m_spacialChunks.end() );
 					}
 
@@ -167,8 +167,6 @@ namespace Reflex::Core
 		{
 			const auto locTopLeft = CellHash( sf::Vector2f( boundary.left, boundary.top ) );
 			const auto locBotRight = CellHash( sf::Vector2f( boundary.left + boundary.width, boundary.top + boundary.height ) );
-			std::vector< unsigned > ids;
-
 			for( int x = locTopLeft.x; x <= locBotRight.x; ++x )
 			{
 				for( int y = locTopLeft.y; y <= locBotRight.y; ++y )
@@ -198,30 +196,6 @@ namespace Reflex::Core
 		}
 	}
 
-	void TileMap::GetNearby( const Object& object, const float distance, std::vector< Object >& out ) const
-	{
-		ForEachInRange( object, distance, [&out]( const Object& obj )
-		{
-			out.push_back( obj );
-		} );
-	}
-
-	void TileMap::GetNearby( const sf::Vector2f& position, const float distance, std::vector< Object >& out ) const
-	{
-		ForEachInRange( position, distance, [&out]( const Object& obj )
-		{
-			out.push_back( obj );
-		} );
-	}
-
-	void TileMap::GetNearby( const sf::FloatRect& boundary, std::vector< Object >& out ) const
-	{
-		ForEachInBounds( boundary, [&out]( const Object& obj )
-		{
-			out.push_back( obj );
-		} );
-	}
-
 	unsigned TileMap::GetCellId( const Object& object ) const
 	{
 		assert( object );
@@ -272,7 +246,7 @@ namespace Reflex::Core
 		return Object( object ).GetTransform()->getPosition();
 	}
 
-	std::vector< TileMap::Chunk >::iterator TileMap::FindChunk( const sf::Vector2i& chunkIdx )
+	std::pmr::vector< TileMap::Chunk >::iterator TileMap::FindChunk( const sf::Vector2i& chunkIdx )
 	{
 		return std::find_if( m_spacialChunks.begin(), m_spacialChunks.end(), [&]( const Chunk& chunk )
 		{
@@ -2,6 +2,8 @@
 
 #include "Objects/BaseObject.h"
 
+#include <memory_resource>
+
 namespace Reflex { class Object; }
 
 namespace Reflex::Core
@@ -11,7 +13,8 @@ namespace Reflex::Core
 		friend class Reflex::Components::Transform;
 
 	public:
-		explicit TileMap( const unsigned cellSize, const unsigned chunkSizeInCells );
+		// Chunks and their buckets are allocated from the memory resource
+		explicit TileMap( const unsigned cellSize, const unsigned chunkSizeInCells, std::pmr::memory_resource* resource = std::pmr::get_default_resource() );
 
 		void Reset( const unsigned cellSize, const unsigned chunkSizeInCells );
 		void Reset();
@@ -19,6 +22,10 @@ namespace Reflex::Core
 		void Repopulate( World& world, const unsigned cellSize, const unsigned chunkSizeInCells );
 		void Repopulate( World& world );
 
+		// Chunks are square, in world units (cell size * chunk size in cells)
+		unsigned GetChunkSize() const { return m_chunkSize; }
+		sf::Vector2i GetChunkIndex( const sf::Vector2f& position ) const { return ChunkHash( position ); }
+
 		void Insert( const Object& object );
 		void Insert( const Object& object, const sf::FloatRect& boundary );
 
@@ -27,9 +34,15 @@ namespace Reflex::Core
 		void Remove( const Object& object, const sf::Vector2i& chunkIdx, const unsigned cellId );
 		void Remove( const Object& object, const sf::FloatRect& boundary );
 
-		void GetNearby( const Object& object, const float distance, std::vector< Object >& out ) const;
-		void GetNearby( const sf::Vector2f& position, const float distance, std::vector< Object >& out ) const;
-		void GetNearby( const sf::FloatRect& boundary, std::vector< Object >& out ) const;
+		// Out can be any vector of objects, a FrameVector using the world's frame arena avoids heap allocating for per frame queries
+		template< typename Container >
+		void GetNearby( const Object& object, const float distance, Container& out ) const;
+
+		template< typename Container >
+		void GetNearby( const sf::Vector2f& position, const float distance, Container& out ) const;
+
+		template< typename Container >
+		void GetNearby( const sf::FloatRect& boundary, Container& out ) const;
 
 		template< typename Func >
 		void ForEachInRange( const BaseObject& object, const float distance, Func f ) const;
@@ -60,7 +73,7 @@ namespace Reflex::Core
 
 	private:
 		struct Chunk;
-		std::vector< TileMap::Chunk >::iterator FindChunk( const sf::Vector2i& chunkIdx );
+		std::pmr::vector< TileMap::Chunk >::iterator FindChunk( const sf::Vector2i& chunkIdx );
 
 	private:
 		unsigned m_cellSize = 0U;
@@ -69,14 +82,45 @@ namespace Reflex::Core
 
 		struct Chunk
 		{
+			explicit Chunk( std::pmr::memory_resource* resource ) : buckets( resource ) { }
+
 			sf::Vector2i chunk;
-			std::vector< std::vector< BaseObject > > buckets;
+			std::pmr::vector< std::pmr::vector< BaseObject > > buckets;
 			unsigned totalObjects = 0;
 		};
-		std::vector< Chunk > m_spacialChunks;
+
+		std::pmr::memory_resource* m_memoryResource = nullptr;
+		std::pmr::vector< Chunk > m_spacialChunks;
 	};
 
 	// Template function definitions
+	template< typename Container >
+	void TileMap::GetNearby( const Object& object, const float distance, Container& out ) const
+	{
+		ForEachInRange( object, distance, [&out]( const Object& obj )
+		{
+			out.push_back( obj );
+		} );
+	}
+
+	template< typename Container >
+	void TileMap::GetNearby( const sf::Vector2f& position, const float distance, Container& out ) const
+	{
+		ForEachInRange( position, distance, [&out]( const Object& obj )
+		{
+			out.push_back( obj );
+		} );
+	}
+
+	template< typename Container >
+	void TileMap::GetNearby( const sf::FloatRect& boundary, Container& out ) const
+	{
+		ForEachInBounds( boundary, [&out]( const Object& obj )
+		{
+			out.push_back( obj );
+		} );
+	}
+
 	template< typename Func >
 	void TileMap::ForEachInRange( const BaseObject& object, const float distance, Func f ) const
 	{
@@ -111,8 +155,6 @@ namespace Reflex::Core
 		{
 			const auto locTopLeft = CellHash( sf::Vector2f( boundary.left, boundary.top ) );
 			const auto locBotRight = CellHash( sf::Vector2f( boundary.left + boundary.width, boundary.top + boundary.height ) );
-			std::vector< unsigned > ids;
-
 			for( int x = locTopLeft.x; x <= locBotRight.x; ++x )
 			{
 				for( int y = locTopLeft.y; y <= locBotRight.y; ++y )
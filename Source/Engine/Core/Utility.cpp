@@ -7,27 +7,29 @@ namespace Reflex
 
 	std::vector< std::string > Split( const std::string& _strInput, const char _cLetter )
 	{
-		std::vector< std::string > vecReturn;
-		std::string strWriter;
-		strWriter.reserve( _strInput.size() );
+		const auto parts = SplitView( _strInput, _cLetter );
+		return std::vector< std::string >( parts.begin(), parts.end() );
+	}
+
+	std::vector< std::string_view > SplitView( const std::string_view str, const char delimiter )
+	{
+		std::vector< std::string_view > parts;
+		std::size_t start = 0;
 
-		for( unsigned i = 0; i < _strInput.size(); ++i )
+		for( std::size_t i = 0; i < str.size(); ++i )
 		{
-			if( _strInput[i] != _cLetter )
-			{
-				strWriter += _strInput[i];
-			}
-			else
+			if( str[i] == delimiter )
 			{
-				vecReturn.push_back( strWriter );
-				strWriter = "";
+				parts.push_back( str.substr( start, i - start ) );
+				start = i + 1;
 			}
 		}
 
-		if( !strWriter.empty() )
-			vecReturn.push_back( strWriter );
+		// Matches Split, a trailing empty part isn't included
+		if( start < str.size() )
+			parts.push_back( str.substr( start ) );
 
-		return std::move( vecReturn );
+		return parts;
 	}
 
 	// Trim from start (in place)
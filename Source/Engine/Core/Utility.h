@@ -4,9 +4,12 @@
 #include <array>
 #include <vector>
 #include <bitset>
+#include <bit>
 #include <optional>
 #include <math.h>
 #include <sstream>
+#include <string_view>
+#include <charconv>
 #include <ostream>
 #include <processenv.h>
 #include <algorithm>
@@ -22,8 +25,78 @@ namespace Reflex
 {
 	typedef std::type_index Type;
 	typedef unsigned char ComponentFamily;
-	constexpr ComponentFamily MaxComponents = 32;
-	typedef std::bitset< MaxComponents > ComponentsMask;
+	constexpr ComponentFamily MaxComponents = 128;
+
+	// Bit mask of component families, stored as 64 bit words so and / or / compare / contains are a couple of word operations
+	class ComponentsMask
+	{
+	public:
+		static constexpr std::size_t NumWords = ( MaxComponents + 63 ) / 64;
+
+		bool test( const std::size_t family ) const { return ( words[family >> 6] >> ( family & 63 ) ) & 1U; }
+		ComponentsMask& set( const std::size_t family ) { words[family >> 6] |= std::uint64_t( 1 ) << ( family & 63 ); return *this; }
+		ComponentsMask& reset( const std::size_t family ) { words[family >> 6] &= ~( std::uint64_t( 1 ) << ( family & 63 ) ); return *this; }
+		ComponentsMask& set() { words.fill( ~std::uint64_t( 0 ) ); return *this; }
+		ComponentsMask& reset() { words.fill( 0 ); return *this; }
+		constexpr std::size_t size() const { return MaxComponents; }
+
+		bool any() const
+		{
+			for( const auto word : words )
+				if( word )
+					return true;
+			return false;
+		}
+
+		bool none() const { return !any(); }
+
+		std::size_t count() const
+		{
+			std::size_t total = 0;
+			for( const auto word : words )
+				total += std::popcount( word );
+			return total;
+		}
+
+		// True if any family is set in both masks
+		bool Intersects( const ComponentsMask& other ) const
+		{
+			for( std::size_t i = 0; i < NumWords; ++i )
+				if( words[i] & other.words[i] )
+					return true;
+			return false;
+		}
+
+		bool Contains( const ComponentsMask& other ) const
+		{
+			for( std::size_t i = 0; i < NumWords; ++i )
+				if( ( words[i] & other.words[i] ) != other.words[i] )
+					return false;
+			return true;
+		}
+
+		// Calls function( family ) for each set family in ascending order, skipping over unset words / bits
+		template< typename Func >
+		void ForEachSetBit( Func function ) const
+		{
+			for( std::size_t i = 0; i < NumWords; ++i )
+				for( auto word = words[i]; word; word &= word - 1 )
+					function( ComponentFamily( i * 64 + std::countr_zero( word ) ) );
+		}
+
+		ComponentsMask& operator&=( const ComponentsMask& other ) { for( std::size_t i = 0; i < NumWords; ++i ) words[i] &= other.words[i]; return *this; }
+		ComponentsMask& operator|=( const ComponentsMask& other ) { for( std::size_t i = 0; i < NumWords; ++i ) words[i] |= other.words[i]; return *this; }
+		ComponentsMask operator&( const ComponentsMask& other ) const { return ComponentsMask( *this ) &= other; }
+		ComponentsMask operator|( const ComponentsMask& other ) const { return ComponentsMask( *this ) |= other; }
+		bool operator==( const ComponentsMask& other ) const { return words == other.words; }
+		bool operator!=( const ComponentsMask& other ) const { return words != other.words; }
+
+		std::uint64_t GetWord( const std::size_t index ) const { return words[index]; }
+
+	private:
+		std::array< std::uint64_t, NumWords > words = {};
+	};
+
 	extern std::optional< float > box2DUnitToPixelScale;
 
 	// Math common
@@ -196,6 +269,9 @@ namespace Reflex
 	// String functions
 	std::vector< std::string > Split( const std::string& _strInput, const char _cLetter );
 
+	// Same as Split but the parts are views into the input (which must outlive them), so nothing is copied
+	std::vector< std::string_view > SplitView( const std::string_view str, const char delimiter );
+
 	constexpr inline bool IsSpace( const char c )
 	{
 		return c == ' ' || c == '\t';
@@ -214,33 +290,96 @@ namespace Reflex
 		TrimRight( str );
 	}
 
-	template< typename T >
-	T FromString( const std::string& str )
+	// trim from both ends, returning a view of the input
+	constexpr inline std::string_view TrimView( std::string_view str )
 	{
-		T out;
-		std::stringstream stream( str );
-		stream >> out;
-		return out;
+		while( !str.empty() && IsSpace( str.front() ) )
+			str.remove_prefix( 1 );
+		while( !str.empty() && IsSpace( str.back() ) )
+			str.remove_suffix( 1 );
+		return str;
 	}
 
+	// Number parsing / formatting goes through from_chars / to_chars (no locale, streams or allocations)
+	// Parses the next number in the view (skipping separators before it: spaces, commas and brackets) and advances the view past it
 	template< typename T >
-	void FromStringV( const std::string& str, T& t )
+	bool ParseNext( std::string_view& str, T& out )
 	{
-		std::stringstream stream( str );
-		stream >> t;
+		static_assert( std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "Only numbers can be parsed" );
+		const auto start = str.find_first_not_of( " \t\r\n,()" );
+
+		if( start == std::string_view::npos )
+			return false;
+
+		str.remove_prefix( start );
+		const auto [end, error] = std::from_chars( str.data(), str.data() + str.size(), out );
+
+		if( error != std::errc() )
+			return false;
+
+		str.remove_prefix( end - str.data() );
+		return true;
 	}
 
-	template< typename T, typename... Args >
-	void FromStringV( const std::string& str, T& t, Args&... args )
+	// Writes a number into the buffer, returning a view of the characters written (empty if the buffer is too small)
+	template< typename T >
+	std::string_view ToChars( const T value, char* buffer, const std::size_t size )
 	{
-		FromStringV( str, t );
-		FromStringV( str, args... );
+		static_assert( std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "Only numbers can be formatted" );
+		const auto [end, error] = std::to_chars( buffer, buffer + size, value );
+		return error == std::errc() ? std::string_view( buffer, end - buffer ) : std::string_view();
+	}
+
+	template< typename T >
+	T FromString( const std::string_view str )
+	{
+		if constexpr( std::is_arithmetic_v< T > )
+		{
+			T out{};
+			auto remaining = str;
+			ParseNext( remaining, out );
+			return out;
+		}
+		else if constexpr( std::is_same_v< T, std::string > )
+		{
+			// The first word, same as reading it with a stream
+			const auto trimmed = TrimView( str );
+			const auto end = std::find_if( trimmed.begin(), trimmed.end(), IsSpace );
+			return T( trimmed.substr( 0, std::size_t( end - trimmed.begin() ) ) );
+		}
+		else
+		{
+			T out;
+			std::stringstream stream{ std::string( str ) };
+			stream >> out;
+			return out;
+		}
+	}
+
+	// Parses each value in turn from the string (see ParseNext), returns false if it ran out of numbers
+	template< typename... Args >
+	bool FromStringV( std::string_view str, Args&... args )
+	{
+		return ( ParseNext( str, args ) && ... );
 	}
 
 	template< typename T >
 	std::string ToString( const T& t )
 	{
-		return Stream( t );
+		// Chars are left to the stream so they stay characters (unsigned char / sf::Uint8 are formatted as numbers)
+		if constexpr( std::is_arithmetic_v< T > && !std::is_same_v< T, bool > && !std::is_same_v< T, char > )
+		{
+			char buffer[32];
+			return std::string( ToChars( t, buffer, std::size( buffer ) ) );
+		}
+		else if constexpr( std::is_convertible_v< const T&, std::string_view > )
+		{
+			return std::string( std::string_view( t ) );
+		}
+		else
+		{
+			return Stream( t );
+		}
 	}
 
 	template< typename T, typename... Args >
@@ -249,14 +388,50 @@ namespace Reflex
 		return ToString( t ) + ToString( args... );
 	}
 
+	// Numbers separated by ", " (the format FromStringV reads back), formatted into a single stack buffer
+	template< typename... Args >
+	std::string ToStringV( const Args... args )
+	{
+		char buffer[sizeof...( Args ) * 32];
+		std::size_t size = 0;
+
+		const auto append = [&]( const auto value )
+		{
+			if( size )
+			{
+				buffer[size++] = ',';
+				buffer[size++] = ' ';
+			}
+
+			size += ToChars( value, buffer + size, std::size( buffer ) - size ).size();
+		};
+
+		( append( args ), ... );
+		return std::string( buffer, size );
+	}
+
+	// Bools are written as words (the stream defaults would write 1 and only read back numbers)
+	template<>
+	inline std::string ToString< bool >( const bool& value )
+	{
+		return value ? "true" : "false";
+	}
+
+	template<>
+	inline bool FromString< bool >( const std::string_view str )
+	{
+		const auto trimmed = TrimView( str );
+		return trimmed == "true" || trimmed == "1";
+	}
+
 	template<>
 	inline std::string ToString< sf::Vector2f >( const sf::Vector2f& vec )
 	{
-		return ToString( vec.x, ", ", vec.y );
+		return ToStringV( vec.x, vec.y );
 	}
 
 	template<>
-	inline sf::Vector2f FromString< sf::Vector2f >( const std::string& str )
+	inline sf::Vector2f FromString< sf::Vector2f >( const std::string_view str )
 	{
 		sf::Vector2f vec;
 		FromStringV( str, vec.x, vec.y );
@@ -266,11 +441,11 @@ namespace Reflex
 	template<>
 	inline std::string ToString< sf::Color >( const sf::Color& colour )
 	{
-		return ToString( colour.r, ", ", colour.g, ", ", colour.b, ", ", colour.a );
+		return ToStringV( colour.r, colour.g, colour.b, colour.a );
 	}
 
 	template<>
-	inline sf::Color FromString< sf::Color >( const std::string& str )
+	inline sf::Color FromString< sf::Color >( const std::string_view str )
 	{
 		sf::Color colour;
 		FromStringV( str, colour.r, colour.g, colour.b, colour.a );
@@ -280,11 +455,11 @@ namespace Reflex
 	template<>
 	inline std::string ToString< sf::Vector2u >( const sf::Vector2u& vec )
 	{
-		return ToString( vec.x, ", ", vec.y );
+		return ToStringV( vec.x, vec.y );
 	}
 
 	template<>
-	inline sf::Vector2u FromString< sf::Vector2u >( const std::string& str )
+	inline sf::Vector2u FromString< sf::Vector2u >( const std::string_view str )
 	{
 		sf::Vector2u vec;
 		FromStringV( str, vec.x, vec.y );
@@ -294,11 +469,11 @@ namespace Reflex
 	template<>
 	inline std::string ToString< sf::Vector2i >( const sf::Vector2i& vec )
 	{
-		return ToString( vec.x, ", ", vec.y );
+		return ToStringV( vec.x, vec.y );
 	}
 
 	template<>
-	inline sf::Vector2i FromString< sf::Vector2i >( const std::string& str )
+	inline sf::Vector2i FromString< sf::Vector2i >( const std::string_view str )
 	{
 		sf::Vector2i vec;
 		FromStringV( str, vec.x, vec.y );
@@ -632,38 +807,38 @@ namespace Reflex
 		return container[RandomUnsigned( ( unsigned )container.size() )];
 	}
 
-	template< typename T >
-	typename std::vector<T>::const_iterator Erase( std::vector<T>& container, const T& value )
+	template< typename T, typename Alloc >
+	typename std::vector< T, Alloc >::const_iterator Erase( std::vector< T, Alloc >& container, const T& value )
 	{
-		return container.erase( container.begin(), container.end(), value );
+		return container.erase( std::remove( container.begin(), container.end(), value ), container.end() );
 	}
 
-	template< typename T, typename Pred >
-	typename std::vector<T>::const_iterator EraseIf( std::vector<T>& container, const Pred& pred )
+	template< typename T, typename Alloc, typename Pred >
+	typename std::vector< T, Alloc >::const_iterator EraseIf( std::vector< T, Alloc >& container, const Pred& pred )
 	{
 		return container.erase( std::remove_if( container.begin(), container.end(), pred ), container.end() );
 	}
 
-	template< typename T >
-	typename std::vector<T>::const_iterator Find( const std::vector<T>& container, const T& value )
+	template< typename T, typename Alloc >
+	typename std::vector< T, Alloc >::const_iterator Find( const std::vector< T, Alloc >& container, const T& value )
 	{
 		return std::find( container.begin(), container.end(), value );
 	}
 
-	template< typename T, typename Pred >
-	typename std::vector<T>::const_iterator FindIf( const std::vector<T>& container, const Pred& pred )
+	template< typename T, typename Alloc, typename Pred >
+	typename std::vector< T, Alloc >::const_iterator FindIf( const std::vector< T, Alloc >& container, const Pred& pred )
 	{
 		return std::find_if( container.begin(), container.end(), pred );
 	}
 
-	template< typename T >
-	bool Contains( const std::vector< T >& container, const T& value )
+	template< typename T, typename Alloc >
+	bool Contains( const std::vector< T, Alloc >& container, const T& value )
 	{
 		return Find( container, value ) != container.end();
 	}
 
-	template< typename T, typename Pred >
-	bool ContainsIf( const std::vector< T >& container, const Pred& pred )
+	template< typename T, typename Alloc, typename Pred >
+	bool ContainsIf( const std::vector< T, Alloc >& container, const Pred& pred )
 	{
 		return FindIf( container, pred ) != container.end();
 	}
@@ -697,6 +872,7 @@ namespace Reflex
     }
 }
 
+MAKE_HASHABLE( Reflex::ComponentsMask, t.GetWord( 0 ), t.GetWord( Reflex::ComponentsMask::NumWords - 1 ) )
 MAKE_HASHABLE( sf::Vector2f, t.x, t.y )
 MAKE_HASHABLE( sf::Vector2i, t.x, t.y )
 MAKE_HASHABLE( sf::Vector2u, t.x, t.y )
\ No newline at end of file
@@ -18,19 +18,32 @@
 #include "Systems/2D/CameraSystem.h"
 #include "Systems/2D/SteeringSystem.h"
 #include "Systems/2D/PhysicsSystem.h"
+#include "JobSystem.h"
+#include "Snapshot.h"
 
 namespace Reflex::Core
 {
-	World::World( const Context& context, const sf::FloatRect& worldBounds, const sf::Vector2f& gravity )
-		: m_context( context )
+	World::World( const Context& context, const sf::FloatRect& worldBounds, const sf::Vector2f& gravity, const StorageMode storageMode, std::pmr::memory_resource* memoryResource )
+		: m_startupClock()
+		, m_memoryResource( memoryResource )
+		, m_context( context )
 		, m_worldView( context.window.getDefaultView() )
 		, m_worldBounds( worldBounds )
-		, m_tileMap( 200, 20 )
 		, m_box2DWorld( std::make_unique< b2World >( b2Vec2( gravity.x, gravity.y ) ) )
 		, m_box2DDebugDraw( context.window, m_box2DUnitToPixelScale )
+		, eventManager( memoryResource )
+		, m_tileMap( 200, 20, memoryResource )
+		, m_regionStreamer( *this )
+		, m_objects( memoryResource )
+		, m_storageMode( storageMode )
+		, m_components( memoryResource )
+		, m_archetypes( memoryResource )
+		, m_freeList( memoryResource )
 	{
 		Reflex::box2DUnitToPixelScale = m_box2DUnitToPixelScale;
+		m_startupTimings.push_back( { "Members", m_startupClock.getElapsedTime() } );
 		Setup();
+		m_startupTimings.push_back( { "Total", m_startupClock.getElapsedTime() } );
 	}
 
 	World::~World()
@@ -40,27 +53,33 @@ namespace Reflex::Core
 
 	void World::Setup()
 	{
-		RegisterComponent< Reflex::Components::Transform >();
-		RegisterComponent< Reflex::Components::Interactable >();
-		RegisterComponent< Reflex::Components::CircleShape >();
-		RegisterComponent< Reflex::Components::RectangleShape >();
-		RegisterComponent< Reflex::Components::ConvexShape >();
-		RegisterComponent< Reflex::Components::Sprite >();
-		RegisterComponent< Reflex::Components::Text >();
-		RegisterComponent< Reflex::Components::Grid >();
-		RegisterComponent< Reflex::Components::Camera >();
-		RegisterComponent< Reflex::Components::Steering >();
-		RegisterComponent< Reflex::Components::RigidBody >();
-		RegisterComponent< Reflex::Components::CircleCollider >();
-
-		AddSystem< Reflex::Systems::RenderSystem >();
-		AddSystem< Reflex::Systems::InteractableSystem >();
-		AddSystem< Reflex::Systems::MovementSystem >();
-		AddSystem< Reflex::Systems::CameraSystem >();
-		AddSystem< Reflex::Systems::SteeringSystem >();
-		AddSystem< Reflex::Systems::PhysicsSystem >();
-
-		m_sceneGraphRoot = CreateObject( sf::Vector2f( 0.0f, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+		// Registering only creates the (empty) pools, no component memory is committed until the first component of a type is constructed
+		RegisterStartupComponents< 
+			Reflex::Components::Transform,
+			Reflex::Components::Interactable,
+			Reflex::Components::CircleShape,
+			Reflex::Components::RectangleShape,
+			Reflex::Components::ConvexShape,
+			Reflex::Components::Sprite,
+			Reflex::Components::Text,
+			Reflex::Components::Grid,
+			Reflex::Components::Camera,
+			Reflex::Components::Steering,
+			Reflex::Components::RigidBody,
+			Reflex::Components::CircleCollider >();
+
+		AddStartupSystems<
+			Reflex::Systems::RenderSystem,
+			Reflex::Systems::InteractableSystem,
+			Reflex::Systems::MovementSystem,
+			Reflex::Systems::CameraSystem,
+			Reflex::Systems::SteeringSystem,
+			Reflex::Systems::PhysicsSystem >();
+
+		TimeStartupStep( "Scene root", [this]()
+		{
+			m_sceneGraphRoot = CreateObject( sf::Vector2f( 0.0f, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+		} );
 
 		m_box2DDebugDraw.SetFlags( -1 );
 		m_box2DWorld->SetDebugDraw( &m_box2DDebugDraw );
@@ -74,16 +93,27 @@ namespace Reflex::Core
 		m_deltaTime = deltaTime;
 		m_box2DWorld->Step( deltaTime, m_box2DVelocityIterations, m_box2DPositionIterations );
 
-		// Update systems
-		for( auto& system : m_systems )
-			system.second->Update( deltaTime );
+		// Sync point, apply anything recorded since the last update (including physics callbacks)
+		FlushCommands();
+
+		// Streamed regions are inserted / removed in bulk here, before any system sees the world this frame
+		m_regionStreamer.Update();
+
+		UpdateSystems( deltaTime );
+
+		// Sync point, apply changes recorded by the systems
+		FlushCommands();
+
+		m_frameArena.Reset();
 	}
 
 	void World::ProcessEvent( const sf::Event& event )
 	{
 		PROFILE;
-		for( auto& system : m_systems )
-			system.second->ProcessEvent( event );
+		for( auto* system : m_systemOrder )
+			system->ProcessEvent( event );
+
+		FlushCommands();
 	}
 
 	void World::Render()
@@ -92,10 +122,10 @@ namespace Reflex::Core
 		const auto camera = GetActiveCamera();
 		GetWindow().setView( camera ? *camera : m_worldView );
 
-		for( auto& system : m_systems )
+		for( auto* system : m_systemOrder )
 		{
-			system.second->RenderUI();
-			GetWindow().draw( *system.second );
+			system->RenderUI();
+			GetWindow().draw( *system );
 		}
 
 		m_box2DWorld->DebugDraw();
@@ -106,8 +136,18 @@ namespace Reflex::Core
 			m_box2DWorld->SetDebugDraw( m_box2DUseDebugDraw ? &m_box2DDebugDraw : nullptr );
 		ImGui::InputInt( "Box2D Position Iterations", &m_box2DPositionIterations );
 		ImGui::InputInt( "Box2D Velocity Iterations", &m_box2DVelocityIterations );
+		const auto metrics = GetObjectMetrics();
+		ImGui::Text( "Objects: %u live, %u free, %u peak, %u reused, %u retired", ( unsigned )metrics.live, ( unsigned )metrics.free, ( unsigned )metrics.peak, ( unsigned )metrics.reused, ( unsigned )metrics.retired );
+		ImGui::Text( m_storageMode == StorageMode::Archetype ? "Component Storage: Archetypes (%u)" : "Component Storage: Sparse Sets", ( unsigned )m_archetypes.size() );
+
+		if( ImGui::CollapsingHeader( "Startup Timings" ) )
+			for( const auto& timing : m_startupTimings )
+				ImGui::Text( "%s: %lldus", timing.name.c_str(), ( long long )timing.time.asMicroseconds() );
+
+		ImGui::Text( "Frame Arena: %ukb used, %ukb peak, %ukb capacity, %u overflows", ( unsigned )m_frameArena.GetUsed() / 1024, ( unsigned )m_frameArena.GetPeak() / 1024, ( unsigned )m_frameArena.GetCapacity() / 1024, ( unsigned )m_frameArena.GetOverflowCount() );
 
 		ImGui::End();
+		m_frameArena.Reset();
 	}
 
 	Object World::CreateObject( const sf::Vector2f& position, const float rotation, const sf::Vector2f& scale, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
@@ -116,21 +156,18 @@ namespace Reflex::Core
 
 		if( !m_freeList.empty() )
 		{
-			index = m_freeList.back();
-			m_objects.flags[index].reset();
-			m_freeList.pop();
+			index = PopFreeIndex();
 		}
 		else
 		{
 			m_objects.components.emplace_back();
 			m_objects.flags.emplace_back();
 			m_objects.counters.emplace_back();
+			m_objects.locations.emplace_back();
 			index = ( unsigned )m_objects.components.size() - 1;
-
-			for( auto& allocator : m_components )
-				allocator->ExpandToFit( index + 1 );
 		}
 
+		OnObjectsCreated( 1 );
 		Object newObject = ObjectFromIndex( index );
 		const auto transform = newObject.AddComponent< Reflex::Components::Transform >( position, rotation, scale, useTileMap );
 
@@ -145,10 +182,117 @@ namespace Reflex::Core
 		return newObject;
 	}
 
+	void World::CreateObjects( const std::size_t count, std::vector< Object >& out, const sf::Vector2f& position, const float rotation, const sf::Vector2f& scale, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
+	{
+		CreateObjects( &position, 0, count, out, rotation, scale, attachToRoot, useTileMap );
+	}
+
+	void World::CreateObjects( const std::vector< sf::Vector2f >& positions, std::vector< Object >& out, const float rotation, const sf::Vector2f& scale, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
+	{
+		CreateObjects( positions.data(), 1, positions.size(), out, rotation, scale, attachToRoot, useTileMap );
+	}
+
+	void World::CreateObjects( const sf::Vector2f* positions, const std::size_t positionStride, const std::size_t count, std::vector< Object >& out, const float rotation, const sf::Vector2f& scale, const bool attachToRoot, const bool useTileMap )
+	{
+		using Reflex::Components::Transform;
+
+		if( count == 0 )
+			return;
+
+		const auto first = out.size();
+		out.reserve( first + count );
+
+		// Reuse free indices first, then grow the object data once for the rest
+		while( !m_freeList.empty() && out.size() - first < count )
+			out.push_back( ObjectFromIndex( PopFreeIndex() ) );
+
+		const auto start = m_objects.components.size();
+		const auto end = start + ( first + count - out.size() );
+		m_objects.components.resize( end );
+		m_objects.flags.resize( end );
+		m_objects.counters.resize( end );
+		m_objects.locations.resize( end );
+
+		for( auto index = start; index < end; ++index )
+			out.push_back( ObjectFromIndex( ( unsigned )index ) );
+
+		OnObjectsCreated( count );
+
+		// Construct all the transforms before any notifications go out
+		RegisterComponent< Transform >();
+		const auto family = Transform::GetFamily();
+		auto* allocator = static_cast< ComponentAllocator< Transform >* >( m_components[family].get() );
+
+		if( m_storageMode == StorageMode::SparseSet )
+			allocator->Reserve( allocator->GetCount() + count );
+
+		for( std::size_t i = 0; i < count; ++i )
+		{
+			const auto& object = out[first + i];
+			const auto& position = positions[i * positionStride];
+
+			if( m_storageMode == StorageMode::Archetype )
+				new( ArchetypeAddComponent( object, family ) ) Transform( object, position, rotation, scale, useTileMap );
+			else
+				allocator->Construct( object.GetIndex(), object, position, rotation, scale, useTileMap );
+
+			m_objects.components[object.GetIndex()].set( family );
+		}
+
+		++m_structuralVersion;
+
+		// Every new object has the same components, so each view only needs testing once
+		for( auto& view : m_views )
+			if( m_objects.components[out[first].GetIndex()].Contains( view->mask ) )
+				for( std::size_t i = first; i < out.size(); ++i )
+					view->objects.Insert( out[i].GetIndex() );
+
+		// Tilemap insertion
+		for( std::size_t i = first; i < out.size(); ++i )
+			ObjectGetComponent< Transform >( out[i] )->OnConstructionComplete();
+
+		// The objects are brand new so they can't already be in a system, and only have a transform so only its observers can want them
+		for( auto* baseSystem : GetComponentObservers( Transform::GetFamily() ) )
+		{
+			auto* system = static_cast< Reflex::Systems::System* >( baseSystem );
+
+			for( std::size_t i = first; i < out.size(); ++i )
+			{
+				if( !system->ShouldAddObject( out[i], m_objects.components[out[i].GetIndex()] ) )
+					continue;
+
+				system->AddComponent( out[i] );
+				system->OnComponentAdded( out[i] );
+			}
+		}
+
+		const auto sceneRoot = attachToRoot ? GetSceneRoot() : Transform::Handle();
+		assert( !attachToRoot || sceneRoot.IsValid() );
+
+		for( std::size_t i = first; i < out.size(); ++i )
+		{
+			if( attachToRoot )
+				sceneRoot->AttachChild( out[i] );
+
+			SetObjectFlag( out[i], ObjectFlags::ConstructionComplete );
+		}
+	}
+
 	Object World::CreateObject( const std::string& objectFile, const sf::Vector2f& position, const float rotation, const sf::Vector2f& scale, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
 	{
-		auto newObject = CreateObject( position, rotation, scale, attachToRoot, useTileMap );
-		
+		const auto& prefab = GetPrefab( objectFile );
+		const auto newObject = CreateObject( prefab.m_position.value_or( position ), prefab.m_rotation.value_or( rotation ), prefab.m_scale.value_or( scale ), attachToRoot, useTileMap );
+		ApplyPrefab( prefab, newObject );
+		return newObject;
+	}
+
+	const Prefab& World::GetPrefab( const std::string& objectFile )
+	{
+		const auto cached = m_prefabs.find( objectFile );
+
+		if( cached != m_prefabs.end() )
+			return *cached->second;
+
 		const auto dot = objectFile.rfind( '.' );
 
 		if( dot == std::string::npos )
@@ -174,36 +318,629 @@ namespace Reflex::Core
 		if( !Json::parseFromStream( reader, input, &obj, &errs ) )
 			THROW( "Invalid object file data: " << objectFile );
 
+		auto prefab = std::make_unique< Prefab >( objectFile, m_memoryResource );
+
+		// The values are applied to a scratch object once, which checks they are valid and builds the prototypes
+		const auto scratch = CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+
+		// Destroyed however this returns, as invalid values throw part way through
+		struct ScratchGuard
+		{
+			World& world;
+			const Object& object;
+			~ScratchGuard() { world.DestroyObject( object ); }
+		} scratchGuard{ *this, scratch };
+
 		const auto& components = obj["Components"];
 
-		for( unsigned i = 0; i < components.getMemberNames().size(); ++i )
+		for( const auto& componentName : components.getMemberNames() )
 		{
-			const auto componentName = components.getMemberNames()[i];
 			const auto found = m_componentNameToIndex.find( componentName );
 
 			if( found == m_componentNameToIndex.end() )
 				THROW( "Invalid component name in file: " << objectFile << " , component: " << componentName );
 
-			Reflex::Components::BaseComponent* component = nullptr;
-				
-			if( componentName == Reflex::Components::Transform::GetComponentName() )
-				component = ObjectGetComponent( newObject, found->second );
-			else
-				component = ObjectAddEmptyComponent( newObject, found->second );
-				
+			const auto family = ( ComponentFamily )found->second;
+			const auto isTransform = componentName == Reflex::Components::Transform::GetComponentName();
+			auto* component = isTransform ? ObjectGetComponent( scratch, family ) : ObjectAddEmptyComponent( scratch, family );
+
 			const auto& componentData = components[componentName];
-			for( unsigned j = 0; j < componentData.getMemberNames().size(); ++j )
+			Prefab::Values values;
+
+			for( const auto& variable : componentData.getMemberNames() )
 			{
-				const auto variable = componentData.getMemberNames()[j];
-				const auto value = componentData[variable].asString();
-				if( !component->SetValue( variable, value ) )
+				values.emplace_back( variable, componentData[variable].asString() );
+
+				if( !component->SetValue( variable, values.back().second ) )
 					THROW( "Invalid component variable name in file: " << objectFile << " , component: " << componentName << ", variable: " << variable );
 			}
+
+			if( isTransform )
+			{
+				// Placement is resolved when the object is created rather than moving it afterwards
+				for( auto& [variable, value] : values )
+				{
+					if( variable == "Position" )
+						prefab->m_position = Reflex::FromString< sf::Vector2f >( value );
+					else if( variable == "Rotation" )
+						prefab->m_rotation = Reflex::FromString< float >( value );
+					else if( variable == "Scale" )
+						prefab->m_scale = Reflex::FromString< sf::Vector2f >( value );
+					else
+						prefab->m_transformValues.emplace_back( std::move( variable ), std::move( value ) );
+				}
+			}
+			else if( m_components[family]->IsCopyable() )
+				prefab->AddPrototype( family, *m_components[family], component );
+			else
+			{
+				// Reflected fields are stored parsed, values which aren't plain fields (custom SetValue) keep the string path
+				const auto* typeInfo = GetComponentTypeInfo( family );
+				std::vector< const FieldInfo* > fields;
+
+				for( const auto& [variable, value] : values )
+					if( const auto* field = typeInfo ? typeInfo->FindField( variable ) : nullptr )
+						fields.push_back( field );
+
+				if( fields.size() == values.size() )
+				{
+					SnapshotWriter fieldData;
+					component->WriteFields( fields, fieldData );
+					prefab->AddFields( family, std::move( fields ), std::move( fieldData ) );
+				}
+				else
+					prefab->AddValues( family, std::move( values ) );
+			}
 		}
 
+		return *m_prefabs.emplace( objectFile, std::move( prefab ) ).first->second;
+	}
+
+	Object World::Instantiate( const Prefab& prefab, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
+	{
+		const auto newObject = CreateObject( prefab.m_position.value_or( sf::Vector2f() ), prefab.m_rotation.value_or( 0.0f ), prefab.m_scale.value_or( sf::Vector2f( 1.0f, 1.0f ) ), attachToRoot, useTileMap );
+		ApplyPrefab( prefab, newObject );
 		return newObject;
 	}
 
+	void World::Instantiate( const Prefab& prefab, const std::size_t count, std::vector< Object >& out, const bool attachToRoot /*= true*/, const bool useTileMap /*= true*/ )
+	{
+		const auto first = out.size();
+		CreateObjects( count, out, prefab.m_position.value_or( sf::Vector2f() ), prefab.m_rotation.value_or( 0.0f ), prefab.m_scale.value_or( sf::Vector2f( 1.0f, 1.0f ) ), attachToRoot, useTileMap );
+
+		for( auto i = first; i < out.size(); ++i )
+			ApplyPrefab( prefab, out[i] );
+	}
+
+	void World::ApplyPrefab( const Prefab& prefab, const Object& object )
+	{
+		if( !prefab.m_transformValues.empty() )
+		{
+			auto* transform = ObjectGetComponent< Reflex::Components::Transform >( object );
+
+			for( const auto& [variable, value] : prefab.m_transformValues )
+				transform->SetValue( variable, value );
+		}
+
+		for( const auto& component : prefab.m_components )
+		{
+			if( component.prototype )
+			{
+				ObjectAddComponentCopy( object, component.family, component.prototype );
+				continue;
+			}
+
+			auto* added = ObjectAddEmptyComponent( object, component.family );
+			SnapshotReader fieldData( component.fieldData.GetData(), component.fieldData.GetSize() );
+			added->ReadFields( component.fields, fieldData );
+
+			for( const auto& [variable, value] : component.values )
+				added->SetValue( variable, value );
+		}
+	}
+
+	std::vector< Object > World::WriteObjects( const std::vector< Object >& roots, SnapshotWriter& writer ) const
+	{
+		PROFILE;
+		using Reflex::Components::Transform;
+
+		// Breadth first from each root, so every parent is written (and read back) before its children
+		std::vector< Object > objects;
+		std::vector< std::uint32_t > parents;
+
+		for( const auto& root : roots )
+		{
+			objects.push_back( root );
+			parents.push_back( SparseIndex::InvalidIndex );
+
+			for( auto i = objects.size() - 1; i < objects.size(); ++i )
+			{
+				for( const auto& child : static_cast< const Transform* >( ObjectGetComponent( objects[i], Transform::GetFamily() ) )->m_children )
+				{
+					objects.push_back( child );
+					parents.push_back( ( std::uint32_t )i );
+				}
+			}
+		}
+
+		std::vector< const std::string* > names( m_components.size(), nullptr );
+		for( const auto& [name, family] : m_componentNameToIndex )
+			names[family] = &name;
+
+		// Transforms then rigid bodies first, as reading the components that follow relies on them
+		const auto transformFamily = Transform::GetFamily();
+		const auto rigidBodyFamily = Reflex::Components::RigidBody::GetFamily();
+		std::vector< ComponentFamily > families;
+
+		writer.Write( ( std::uint32_t )objects.size() );
+
+		for( std::size_t i = 0; i < objects.size(); ++i )
+		{
+			const auto& mask = m_objects.components[objects[i].GetIndex()];
+			families.assign( 1, transformFamily );
+
+			if( mask.test( rigidBodyFamily ) )
+				families.push_back( rigidBodyFamily );
+
+			for( ComponentFamily family = 0; family < m_components.size(); ++family )
+				if( mask.test( family ) && family != transformFamily && family != rigidBodyFamily )
+					families.push_back( family );
+
+			writer.Write( parents[i] );
+			writer.Write( ( std::uint32_t )families.size() );
+
+			for( const auto family : families )
+			{
+				writer.WriteString( *names[family] );
+
+				// Size of the component's data, so reading can check every object before it creates any
+				const auto sizeOffset = writer.GetSize();
+				writer.Write( std::uint32_t( 0 ) );
+				ObjectGetComponent( objects[i], family )->WriteSnapshot( writer );
+				writer.WriteAt( sizeOffset, std::uint32_t( writer.GetSize() - sizeOffset - sizeof( std::uint32_t ) ) );
+			}
+		}
+
+		return objects;
+	}
+
+	void World::ReadObjects( SnapshotReader& reader, std::vector< Object >& out )
+	{
+		PROFILE;
+		using Reflex::Components::Transform;
+
+		// Everything but the component data itself is read and checked before any object is created
+		struct ObjectData
+		{
+			std::uint32_t parent = SparseIndex::InvalidIndex;
+			std::vector< std::pair< ComponentFamily, SnapshotReader > > components;
+		};
+
+		// Every object is at least a parent and a component count
+		const auto count = reader.Read< std::uint32_t >();
+
+		if( count > reader.GetRemaining() / ( sizeof( std::uint32_t ) * 2 ) )
+			THROW( "Invalid object data, " << count << " objects don't fit in the remaining " << reader.GetRemaining() << " bytes" );
+
+		std::vector< ObjectData > objects( count );
+
+		for( std::uint32_t i = 0; i < count; ++i )
+		{
+			auto& [parent, components] = objects[i];
+			parent = reader.Read< std::uint32_t >();
+
+			if( parent != SparseIndex::InvalidIndex && parent >= i )
+				THROW( "Invalid object data, parent " << parent << " is not written before object " << i );
+
+			const auto componentCount = reader.Read< std::uint32_t >();
+			ComponentsMask mask;
+
+			for( std::uint32_t c = 0; c < componentCount; ++c )
+			{
+				const auto name = reader.ReadString();
+				const auto found = m_componentNameToIndex.find( name );
+
+				if( found == m_componentNameToIndex.end() )
+					THROW( "Invalid component name in object data: " << name );
+
+				const auto family = ( ComponentFamily )found->second;
+
+				if( mask.test( family ) )
+					THROW( "Invalid object data, object " << i << " has more than one " << name << " component" );
+
+				mask.set( family );
+
+				const auto size = reader.Read< std::uint32_t >();
+				components.emplace_back( family, SnapshotReader( reader.ReadBytes( size ), size ) );
+			}
+
+			if( !mask.test( Transform::GetFamily() ) )
+				THROW( "Invalid object data, object " << i << " has no transform" );
+		}
+
+		const auto first = out.size();
+		out.reserve( first + count );
+
+		while( !m_freeList.empty() && out.size() - first < count )
+			out.push_back( ObjectFromIndex( PopFreeIndex() ) );
+
+		const auto start = m_objects.components.size();
+		const auto end = start + ( first + count - out.size() );
+		m_objects.components.resize( end );
+		m_objects.flags.resize( end );
+		m_objects.counters.resize( end );
+		m_objects.locations.resize( end );
+
+		for( auto index = start; index < end; ++index )
+			out.push_back( ObjectFromIndex( ( unsigned )index ) );
+
+		OnObjectsCreated( count );
+
+		// Construct and read every component before any of them complete construction
+		std::vector< std::pair< Object, ComponentFamily > > constructed;
+
+		try
+		{
+			for( std::uint32_t i = 0; i < count; ++i )
+			{
+				const auto& object = out[first + i];
+
+				for( auto& [family, data] : objects[i].components )
+				{
+					auto& type = *m_components[family];
+					auto* component = static_cast< Reflex::Components::BaseComponent* >( m_storageMode == StorageMode::Archetype
+						? type.ConstructEmptyAt( ArchetypeAddComponent( object, family ), object )
+						: type.ConstructEmpty( object.GetIndex(), object ) );
+					m_objects.components[object.GetIndex()].set( family );
+					constructed.emplace_back( object, family );
+					component->ReadSnapshot( data );
+
+					if( data.GetRemaining() != 0 )
+						THROW( "Invalid object data, a component of object " << i << " didn't read all of its data (" << data.GetRemaining() << " bytes left)" );
+				}
+			}
+		}
+		catch( ... )
+		{
+			// The component data can only be checked by reading it, so the objects created for it are removed again
+			DiscardUnconstructedObjects( out, first );
+			out.resize( first );
+			throw;
+		}
+
+		++m_structuralVersion;
+
+		// Link the scene graph first so transforms are inserted into the tile map at their world position
+		const auto sceneRoot = GetSceneRoot();
+
+		for( std::uint32_t i = 0; i < count; ++i )
+		{
+			if( objects[i].parent == SparseIndex::InvalidIndex )
+				sceneRoot->AttachChild( out[first + i] );
+			else
+				ObjectGetComponent< Transform >( out[first + objects[i].parent] )->AttachChild( out[first + i] );
+		}
+
+		for( const auto& [object, family] : constructed )
+			ObjectGetComponent( object, family )->OnConstructionComplete();
+
+		for( auto i = first; i < out.size(); ++i )
+		{
+			const auto index = out[i].GetIndex();
+			UpdateViews( index );
+
+			for( auto* system : m_systemOrder )
+			{
+				if( !system->ShouldAddObject( out[i], m_objects.components[index] ) )
+					continue;
+
+				system->AddComponent( out[i] );
+				system->OnComponentAdded( out[i] );
+			}
+
+			SetObjectFlag( out[i], ObjectFlags::ConstructionComplete );
+		}
+	}
+
+	bool World::SaveSnapshot( const std::string& path ) const
+	{
+		PROFILE;
+		using Reflex::Components::Transform;
+
+		const auto objectCount = m_objects.counters.size();
+		SnapshotWriter writer( objectCount * 128 );
+		writer.Write( SnapshotMagic );
+		writer.Write( SnapshotVersion );
+
+		// Object table, including destroyed indices so every handle is exactly as valid / invalid after loading
+		std::vector< std::uint32_t > flags( objectCount );
+		for( std::size_t i = 0; i < objectCount; ++i )
+			flags[i] = ( std::uint32_t )m_objects.flags[i].to_ulong();
+
+		const std::vector< std::uint32_t > freeList( m_freeList.begin(), m_freeList.end() );
+		writer.WriteArray( m_objects.counters.data(), objectCount );
+		writer.WriteArray( flags.data(), flags.size() );
+		writer.WriteArray( freeList.data(), freeList.size() );
+		writer.Write( m_sceneGraphRoot.GetIndex() );
+		writer.Write( IsValidObject( m_activeCamera ) ? m_activeCamera.GetIndex() : SparseIndex::InvalidIndex );
+
+		// Transforms then rigid bodies first, as loading the components that follow relies on them
+		std::vector< ComponentFamily > families;
+		const auto transformFamily = Transform::GetFamily();
+		const auto rigidBodyFamily = Reflex::Components::RigidBody::GetFamily();
+		families.push_back( transformFamily );
+		families.push_back( rigidBodyFamily );
+
+		for( ComponentFamily family = 0; family < m_components.size(); ++family )
+			if( m_components[family] && family != transformFamily && family != rigidBodyFamily )
+				families.push_back( family );
+
+		std::vector< std::uint32_t > indices;
+		indices.reserve( objectCount );
+		writer.Write( ( std::uint32_t )families.size() );
+
+		for( const auto family : families )
+		{
+			indices.clear();
+
+			for( std::uint32_t index = 0; index < objectCount; ++index )
+				if( m_objects.components[index].test( family ) )
+					indices.push_back( index );
+
+			const auto name = std::find_if( m_componentNameToIndex.begin(), m_componentNameToIndex.end(), [&]( const auto& pair ) { return pair.second == family; } );
+			assert( name != m_componentNameToIndex.end() );
+
+			writer.WriteString( name->first );
+			writer.WriteArray( indices.data(), indices.size() );
+
+			// Size of the component data, so loading can check the whole file before it touches the world
+			const auto sizeOffset = writer.GetSize();
+			writer.Write( std::uint64_t( 0 ) );
+
+			for( const auto index : indices )
+				ObjectGetComponent( BaseObject( const_cast< World& >( *this ), index, m_objects.counters[index] ), family )->WriteSnapshot( writer );
+
+			writer.WriteAt( sizeOffset, std::uint64_t( writer.GetSize() - sizeOffset - sizeof( std::uint64_t ) ) );
+
+			// Scene graph, stored by index with the transforms
+			if( family != transformFamily )
+				continue;
+
+			std::vector< std::uint32_t > children;
+
+			for( const auto index : indices )
+			{
+				const auto* transform = static_cast< const Transform* >( ObjectGetComponent( BaseObject( const_cast< World& >( *this ), index, m_objects.counters[index] ), family ) );
+				writer.Write( transform->m_parent ? transform->m_parent.GetIndex() : SparseIndex::InvalidIndex );
+
+				children.clear();
+				for( const auto& child : transform->m_children )
+					children.push_back( child.GetIndex() );
+
+				writer.WriteArray( children.data(), children.size() );
+			}
+		}
+
+		return writer.SaveToFile( path );
+	}
+
+	bool World::LoadSnapshot( const std::string& path )
+	{
+		PROFILE;
+		using Reflex::Components::Transform;
+
+		MappedFile file( path );
+
+		if( !file.IsOpen() )
+			return false;
+
+		SnapshotReader reader( file.GetData(), file.GetSize() );
+
+		if( reader.Read< std::uint32_t >() != SnapshotMagic )
+			THROW( "Invalid world snapshot: " << path );
+
+		const auto version = reader.Read< std::uint32_t >();
+
+		if( version != SnapshotVersion )
+			THROW( "Unsupported world snapshot version: " << path << " (version " << version << ", expected " << SnapshotVersion << ")" );
+
+		// The object table, component indices and scene graph are read and checked before the world is touched, so a bad one leaves the current world as it was
+		// Component data can only be checked by reading it once the world has been cleared, if that fails the world is left empty (with a new scene root)
+		std::vector< std::uint32_t > counters, flags, freeList;
+		reader.ReadArray( counters );
+		reader.ReadArray( flags );
+		reader.ReadArray( freeList );
+
+		const auto objectCount = counters.size();
+		const auto sceneRoot = reader.Read< std::uint32_t >();
+		const auto activeCamera = reader.Read< std::uint32_t >();
+
+		if( flags.size() != objectCount || sceneRoot >= objectCount || ( activeCamera != SparseIndex::InvalidIndex && activeCamera >= objectCount ) )
+			THROW( "Invalid world snapshot: " << path );
+
+		if( std::any_of( freeList.begin(), freeList.end(), [&]( const std::uint32_t index ) { return index >= objectCount; } ) )
+			THROW( "Invalid world snapshot: " << path );
+
+		struct LoadedFamily
+		{
+			ComponentFamily family = 0;
+			std::vector< std::uint32_t > indices;
+			SnapshotReader data = SnapshotReader( nullptr, 0 );
+
+			// Scene graph, only for transforms
+			std::vector< std::uint32_t > parents;
+			std::vector< std::vector< std::uint32_t > > children;
+		};
+
+		const auto familyCount = reader.Read< std::uint32_t >();
+
+		if( familyCount > MaxComponents )
+			THROW( "Invalid world snapshot: " << path );
+
+		std::vector< LoadedFamily > loaded( familyCount );
+		ComponentsMask loadedFamilies;
+
+		const auto isValidIndex = [&]( const std::uint32_t index ) { return index < objectCount; };
+		const auto isLive = [&]( const std::uint32_t index ) { return ( flags[index] & ( 1u << ( unsigned )ObjectFlags::Deleted ) ) == 0; };
+		std::vector< std::uint32_t > sorted;
+
+		for( auto& [family, indices, data, parents, children] : loaded )
+		{
+			const auto name = reader.ReadString();
+			const auto found = m_componentNameToIndex.find( name );
+
+			if( found == m_componentNameToIndex.end() )
+				THROW( "Invalid component name in snapshot: " << path << ", component: " << name );
+
+			family = ( ComponentFamily )found->second;
+			reader.ReadArray( indices );
+
+			if( loadedFamilies.test( family ) || !std::all_of( indices.begin(), indices.end(), isValidIndex ) || !std::all_of( indices.begin(), indices.end(), isLive ) )
+				THROW( "Invalid world snapshot: " << path );
+
+			// An object can only have one of each component
+			sorted.assign( indices.begin(), indices.end() );
+			std::sort( sorted.begin(), sorted.end() );
+
+			if( std::adjacent_find( sorted.begin(), sorted.end() ) != sorted.end() )
+				THROW( "Invalid world snapshot: " << path );
+
+			loadedFamilies.set( family );
+
+			const auto dataSize = ( std::size_t )reader.Read< std::uint64_t >();
+			data = SnapshotReader( reader.ReadBytes( dataSize ), dataSize );
+
+			if( family != Transform::GetFamily() )
+				continue;
+
+			parents.resize( indices.size() );
+			children.resize( indices.size() );
+
+			for( std::size_t i = 0; i < indices.size(); ++i )
+			{
+				parents[i] = reader.Read< std::uint32_t >();
+				reader.ReadArray( children[i] );
+
+				if( ( parents[i] != SparseIndex::InvalidIndex && !isValidIndex( parents[i] ) ) || !std::all_of( children[i].begin(), children[i].end(), isValidIndex ) )
+					THROW( "Invalid world snapshot: " << path );
+			}
+		}
+
+		// Every object that exists has a transform, with unique indices this holds if the transform count matches the live object count
+		const auto transforms = std::find_if( loaded.begin(), loaded.end(), [&]( const LoadedFamily& loadedFamily ) { return loadedFamily.family == Transform::GetFamily(); } );
+		std::size_t liveCount = 0;
+
+		for( std::uint32_t index = 0; index < objectCount; ++index )
+			liveCount += isLive( index ) ? 1 : 0;
+
+		if( transforms == loaded.end() || transforms->indices.size() != liveCount )
+			THROW( "Invalid world snapshot: " << path );
+
+		DestroyAllObjects();
+
+		// Kept so a failure reading the component data can return to an empty world
+		const auto emptyCounters = m_objects.counters;
+		const auto emptyFlags = m_objects.flags;
+		const auto emptyFreeList = m_freeList;
+
+		m_objects.components.assign( objectCount, ComponentsMask() );
+		m_objects.flags.assign( objectCount, {} );
+		m_objects.counters.assign( counters.begin(), counters.end() );
+		m_objects.locations.assign( objectCount, ArchetypeLocation() );
+		m_freeList.assign( freeList.begin(), freeList.end() );
+
+		// Construct each component type in bulk, construction is completed once every component exists
+		try
+		{
+			for( auto& [family, indices, data, parents, children] : loaded )
+			{
+				auto& type = *m_components[family];
+
+				if( m_storageMode == StorageMode::SparseSet )
+					type.Reserve( type.GetCount() + indices.size() );
+
+				for( const auto index : indices )
+				{
+					const auto object = ObjectFromIndex( index );
+					auto* component = static_cast< Reflex::Components::BaseComponent* >( m_storageMode == StorageMode::Archetype
+						? type.ConstructEmptyAt( ArchetypeAddComponent( object, family ), object )
+						: type.ConstructEmpty( index, object ) );
+					m_objects.components[index].set( family );
+					component->ReadSnapshot( data );
+				}
+
+				// A component reading a different amount than it wrote is a bug in its WriteSnapshot / ReadSnapshot, or a corrupt file
+				if( data.GetRemaining() != 0 )
+					THROW( "Invalid world snapshot: " << path << ", a component didn't read all of its data (" << data.GetRemaining() << " bytes left)" );
+
+				for( std::size_t i = 0; i < parents.size(); ++i )
+				{
+					auto* transform = ObjectGetComponent< Transform >( ObjectFromIndex( indices[i] ) );
+					transform->m_parent = parents[i] == SparseIndex::InvalidIndex ? Object() : ObjectFromIndex( parents[i] );
+					transform->m_children.clear();
+
+					for( const auto child : children[i] )
+						transform->m_children.push_back( ObjectFromIndex( child ) );
+				}
+			}
+		}
+		catch( ... )
+		{
+			// No component has completed construction yet, so they are destroyed without callbacks and the world is left empty
+			for( std::uint32_t index = 0; index < objectCount; ++index )
+				DiscardUnconstructedComponents( index );
+
+			m_objects.components.assign( emptyCounters.size(), ComponentsMask() );
+			m_objects.flags.assign( emptyFlags.begin(), emptyFlags.end() );
+			m_objects.counters.assign( emptyCounters.begin(), emptyCounters.end() );
+			m_objects.locations.assign( emptyCounters.size(), ArchetypeLocation() );
+			m_freeList.assign( emptyFreeList.begin(), emptyFreeList.end() );
+			++m_structuralVersion;
+
+			m_sceneGraphRoot = CreateObject( sf::Vector2f( 0.0f, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+			m_activeCamera = BaseObject();
+			throw;
+		}
+
+		++m_structuralVersion;
+
+		for( const auto& loadedFamily : loaded )
+			for( const auto index : loadedFamily.indices )
+				ObjectGetComponent( ObjectFromIndex( index ), loadedFamily.family )->OnConstructionComplete();
+
+		std::size_t live = 0;
+
+		for( std::uint32_t index = 0; index < objectCount; ++index )
+		{
+			m_objects.flags[index] = flags[index];
+
+			if( IsObjectFlagSet( index, ObjectFlags::Deleted ) )
+				continue;
+
+			++live;
+			UpdateViews( index );
+
+			const auto object = ObjectFromIndex( index );
+
+			for( auto* system : m_systemOrder )
+			{
+				if( !system->ShouldAddObject( object, m_objects.components[index] ) )
+					continue;
+
+				system->AddComponent( object );
+				system->OnComponentAdded( object );
+			}
+		}
+
+		m_objectMetrics.live = live;
+		m_objectMetrics.peak = std::max( m_objectMetrics.peak, live );
+		m_objectMetrics.retired = objectCount - live - m_freeList.size();
+
+		m_sceneGraphRoot = ObjectFromIndex( sceneRoot );
+		m_activeCamera = activeCamera == SparseIndex::InvalidIndex ? BaseObject() : ObjectFromIndex( activeCamera );
+		return true;
+	}
+
 	void World::CreateROFile( const std::string& name, const Object& object )
 	{
 		auto path = name;
@@ -255,14 +992,36 @@ namespace Reflex::Core
 	{
 		assert( IsValidObject( object ) );
 		assert( !m_objects.components[object.GetIndex()].test( family ) );
-		assert( family < m_components.size() );
+		assert( family < m_components.size() && m_components[family] );
+
+		auto* newComponent = static_cast< Reflex::Components::BaseComponent* >( m_storageMode == StorageMode::Archetype
+			? m_components[family]->ConstructEmptyAt( ArchetypeAddComponent( object, ( ComponentFamily )family ), object )
+			: m_components[family]->ConstructEmpty( object.GetIndex(), object ) );
+		m_objects.components[object.GetIndex()].set( family );
+		++m_structuralVersion;
+		newComponent->OnConstructionComplete();
+		OnComponentAdded( object, ( ComponentFamily )family );
+		return newComponent;
+	}
+
+	Reflex::Components::BaseComponent* World::ObjectAddComponentCopy( const Object& object, const ComponentFamily family, const void* prototype )
+	{
+		assert( IsValidObject( object ) );
+		assert( !m_objects.components[object.GetIndex()].test( family ) );
+		assert( family < m_components.size() && m_components[family] && m_components[family]->IsCopyable() );
 
-		m_components[family]->ExpandToFit( object.GetIndex() + 1 );
+		auto* newComponent = static_cast< Reflex::Components::BaseComponent* >( m_storageMode == StorageMode::Archetype
+			? m_components[family]->CopyConstructAt( ArchetypeAddComponent( object, family ), prototype )
+			: m_components[family]->ConstructCopy( object.GetIndex(), prototype ) );
+
+		// The copy still belongs to the prototype's object
+		newComponent->m_object = object;
+		newComponent->m_changeTick = m_changeTick;
 
-		auto* newComponent = static_cast< Reflex::Components::BaseComponent* >( m_components[family].get()->ConstructEmpty( object.GetIndex(), ( Object )object ) );
 		m_objects.components[object.GetIndex()].set( family );
+		++m_structuralVersion;
 		newComponent->OnConstructionComplete();
-		OnComponentAdded( object );
+		OnComponentAdded( object, family );
 		return newComponent;
 	}
 
@@ -271,6 +1030,13 @@ namespace Reflex::Core
 		assert( IsValidObject( object ) );
 		if( !ObjectHasComponent( object, family ) )
 			return nullptr;
+
+		if( m_storageMode == StorageMode::Archetype )
+		{
+			const auto& location = m_objects.locations[object.GetIndex()];
+			return static_cast< Reflex::Components::BaseComponent* >( m_archetypes[location.archetype]->Get( ( ComponentFamily )family, location.row ) );
+		}
+
 		return static_cast< Reflex::Components::BaseComponent* >( m_components[family]->Get( object.GetIndex() ) );
 	}
 
@@ -281,11 +1047,27 @@ namespace Reflex::Core
 		if( !ObjectHasComponent( object, family ) )
 			return false;
 
-		auto* component = static_cast< Reflex::Components::BaseComponent* >( m_components[family]->Get( object.GetIndex() ) );
-		OnComponentRemoved( object );
+		auto* component = ObjectGetComponent( object, family );
+		OnComponentRemoved( object, ( ComponentFamily )family );
 		component->OnDestructionBegin();
 		m_objects.components[object.GetIndex()].reset( family );
-		m_components[family].get()->Destroy( object.GetIndex() );
+		UpdateViews( object.GetIndex() );
+		++m_structuralVersion;
+
+		if( m_storageMode == StorageMode::Archetype )
+		{
+			const auto& location = m_objects.locations[object.GetIndex()];
+			m_components[family]->DestroyAt( m_archetypes[location.archetype]->Get( ( ComponentFamily )family, location.row ) );
+			ArchetypeMoveObject( object.GetIndex(), m_objects.components[object.GetIndex()] );
+			return true;
+		}
+
+		// Destroying back fills the hole with the last component in the pool, let it know it has moved
+		const auto relocated = m_components[family]->Destroy( object.GetIndex() );
+
+		if( relocated != ComponentAllocatorBase::InvalidIndex )
+			static_cast< Reflex::Components::BaseComponent* >( m_components[family]->Get( relocated ) )->OnRelocated();
+
 		return true;
 	}
 
@@ -300,9 +1082,235 @@ namespace Reflex::Core
 			return;
 
 		ObjectRemoveAllComponents( object );
-		m_objects.flags[object.GetIndex()] = 0;
-		SetObjectFlag( object, ObjectFlags::Deleted );
-		m_objects.counters[object.GetIndex()]++;
+		ReleaseObjectIndex( object.GetIndex() );
+	}
+
+	void World::ReleaseObjectIndex( const std::uint32_t index )
+	{
+		m_objects.flags[index] = 0;
+		SetObjectFlag( index, ObjectFlags::Deleted );
+		++m_structuralVersion;
+		--m_objectMetrics.live;
+
+		// If the generation counter would wrap, old handles to this index could become valid again, so the index is retired instead
+		if( ++m_objects.counters[index] == std::numeric_limits< unsigned >::max() )
+			++m_objectMetrics.retired;
+		else
+			m_freeList.push_back( index );
+	}
+
+	void World::DiscardUnconstructedObjects( const std::vector< Object >& objects, const std::size_t first )
+	{
+		for( auto i = first; i < objects.size(); ++i )
+		{
+			DiscardUnconstructedComponents( objects[i].GetIndex() );
+			ReleaseObjectIndex( objects[i].GetIndex() );
+		}
+	}
+
+	void World::DiscardUnconstructedComponents( const std::uint32_t index )
+	{
+		// Copied as destroying the components modifies the mask
+		const auto components = m_objects.components[index];
+		components.ForEachSetBit( [&]( const ComponentFamily family )
+		{
+			m_objects.components[index].reset( family );
+
+			if( m_storageMode == StorageMode::Archetype )
+			{
+				const auto& location = m_objects.locations[index];
+				m_components[family]->DestroyAt( m_archetypes[location.archetype]->Get( family, location.row ) );
+				return;
+			}
+
+			const auto relocated = m_components[family]->Destroy( index );
+
+			if( relocated != ComponentAllocatorBase::InvalidIndex )
+				static_cast< Reflex::Components::BaseComponent* >( m_components[family]->Get( relocated ) )->OnRelocated();
+		} );
+
+		// Every component has been destroyed, so this only frees the archetype row
+		if( m_storageMode == StorageMode::Archetype )
+			ArchetypeMoveObject( index, ComponentsMask() );
+	}
+
+	std::uint32_t World::PopFreeIndex()
+	{
+		assert( !m_freeList.empty() );
+		std::uint32_t index = 0;
+
+		if( m_indexReuse == IndexReuse::LIFO )
+		{
+			index = m_freeList.back();
+			m_freeList.pop_back();
+		}
+		else
+		{
+			index = m_freeList.front();
+			m_freeList.pop_front();
+		}
+
+		m_objects.flags[index].reset();
+		++m_objectMetrics.reused;
+		return index;
+	}
+
+	void World::OnObjectsCreated( const std::size_t count )
+	{
+		m_objectMetrics.live += count;
+		m_objectMetrics.peak = std::max( m_objectMetrics.peak, m_objectMetrics.live );
+	}
+
+	std::size_t World::Compact( const bool defragment /*= false*/ )
+	{
+		PROFILE;
+		std::size_t released = 0;
+
+		for( auto& allocator : m_components )
+		{
+			if( !allocator )
+				continue;
+
+			// In archetype mode the components live in the archetypes, so the pools are empty
+			if( defragment && allocator->SortByEntity() )
+			{
+				for( std::size_t slot = 0; slot < allocator->GetCount(); ++slot )
+					static_cast< Reflex::Components::BaseComponent* >( allocator->GetDense( slot ) )->OnRelocated();
+
+				++m_structuralVersion;
+			}
+
+			released += allocator->Shrink();
+		}
+
+		for( auto& archetype : m_archetypes )
+			released += archetype->Shrink();
+
+		for( auto& view : m_views )
+			released += view->objects.Shrink();
+
+		for( auto& [type, baseSystem] : m_systems )
+		{
+			auto* system = static_cast< Reflex::Systems::System* >( baseSystem.get() );
+			released += system->m_objectSlots.Shrink();
+			system->m_releventObjects.shrink_to_fit();
+		}
+
+		m_freeList.shrink_to_fit();
+		return released;
+	}
+
+	World::ObjectMetrics World::GetObjectMetrics() const
+	{
+		auto metrics = m_objectMetrics;
+		metrics.free = m_freeList.size();
+		metrics.capacity = m_objects.counters.size();
+		return metrics;
+	}
+
+	const std::vector< std::vector< Reflex::Systems::BaseSystem* > >& World::GetSchedule()
+	{
+		if( m_scheduleDirty )
+			BuildSchedule();
+
+		return m_schedule;
+	}
+
+	const std::vector< Reflex::Systems::BaseSystem* >& World::GetComponentObservers( const ComponentFamily family )
+	{
+		if( m_observersDirty )
+			BuildObservers();
+
+		return m_componentObservers[family];
+	}
+
+	void World::BuildObservers()
+	{
+		for( auto& observers : m_componentObservers )
+			observers.clear();
+
+		for( auto* system : m_systemOrder )
+			system->GetObservedComponents().ForEachSetBit( [&]( const ComponentFamily family ) { m_componentObservers[family].push_back( system ); } );
+
+		m_observersDirty = false;
+	}
+
+	void World::BuildSchedule()
+	{
+		m_schedule.clear();
+		std::vector< std::size_t > stages( m_systemOrder.size(), 0 );
+
+		for( std::size_t i = 0; i < m_systemOrder.size(); ++i )
+		{
+			for( std::size_t earlier = 0; earlier < i; ++earlier )
+				if( m_systemOrder[i]->ConflictsWith( *m_systemOrder[earlier] ) )
+					stages[i] = std::max( stages[i], stages[earlier] + 1 );
+
+			if( stages[i] >= m_schedule.size() )
+				m_schedule.resize( stages[i] + 1 );
+
+			m_schedule[stages[i]].push_back( m_systemOrder[i] );
+		}
+
+		m_scheduleDirty = false;
+	}
+
+	void World::UpdateSystems( const float deltaTime )
+	{
+		PROFILE;
+		for( const auto& stage : GetSchedule() )
+		{
+			++m_changeTick;
+
+			// Exclusive systems are always alone in their stage
+			if( stage.size() == 1 )
+			{
+				stage.front()->Tick( deltaTime, m_changeTick );
+				continue;
+			}
+
+			if( m_stageCommandBuffers.size() < stage.size() )
+				m_stageCommandBuffers.resize( stage.size() );
+
+			auto& jobSystem = JobSystem::GetJobSystem();
+			JobCounter counter;
+
+			for( std::size_t i = 1; i < stage.size(); ++i )
+				jobSystem.Run( [this, &stage, i, deltaTime]() { UpdateStageSystem( *stage[i], m_stageCommandBuffers[i], deltaTime ); }, counter );
+
+			try
+			{
+				UpdateStageSystem( *stage.front(), m_stageCommandBuffers.front(), deltaTime );
+			}
+			catch( ... )
+			{
+				// The other systems in the stage reference this stack frame, so they must finish before it unwinds
+				jobSystem.Wait( counter );
+				throw;
+			}
+
+			jobSystem.Wait( counter );
+
+			// Merged in schedule order so the changes don't depend on which thread finished first
+			for( std::size_t i = 0; i < stage.size(); ++i )
+				m_commandBuffer.Append( m_stageCommandBuffers[i] );
+		}
+
+		// Changes made outside of the systems get their own tick
+		++m_changeTick;
+	}
+
+	void World::UpdateStageSystem( Reflex::Systems::BaseSystem& system, CommandBuffer& commandBuffer, const float deltaTime )
+	{
+		// Set on the system rather than per thread, the system's jobs run on other threads (which may be updating another system)
+		system.m_commandBuffer = &commandBuffer;
+		system.Tick( deltaTime, m_changeTick );
+		system.m_commandBuffer = &m_commandBuffer;
+	}
+
+	void World::FlushCommands()
+	{
+		m_commandBuffer.Flush( *this );
 	}
 
 	void World::DestroyAllObjects()
@@ -349,9 +1357,80 @@ namespace Reflex::Core
 	{
 		assert( IsValidObject( object ) );
 
-		for( size_t i = 0; i < MaxComponents; ++i )
-			if( m_objects.components[object.GetIndex()].test( i ) )
-				ObjectRemoveComponent( object, i );
+		// Copied as removing components modifies the mask
+		const auto components = m_objects.components[object.GetIndex()];
+		components.ForEachSetBit( [&]( const ComponentFamily family )
+		{
+			ObjectRemoveComponent( object, family );
+		} );
+	}
+
+	void* World::ArchetypeAddComponent( const BaseObject& object, const ComponentFamily family )
+	{
+		auto mask = m_objects.components[object.GetIndex()];
+		mask.set( family );
+		ArchetypeMoveObject( object.GetIndex(), mask );
+
+		const auto& location = m_objects.locations[object.GetIndex()];
+		return m_archetypes[location.archetype]->Get( family, location.row );
+	}
+
+	void World::ArchetypeMoveObject( const std::uint32_t objectIndex, const ComponentsMask& newMask )
+	{
+		ArchetypeLocation destination;
+
+		if( newMask.any() )
+		{
+			destination.archetype = GetOrCreateArchetype( newMask );
+			destination.row = m_archetypes[destination.archetype]->Allocate( objectIndex );
+		}
+
+		const auto source = m_objects.locations[objectIndex];
+		m_objects.locations[objectIndex] = destination;
+
+		if( source.archetype == Archetype::InvalidIndex )
+			return;
+
+		auto& sourceArchetype = *m_archetypes[source.archetype];
+
+		if( destination.archetype != Archetype::InvalidIndex )
+		{
+			sourceArchetype.MoveRow( source.row, *m_archetypes[destination.archetype], destination.row );
+			OnComponentsRelocated( objectIndex );
+		}
+
+		// Erasing back fills the row with the last object in the archetype
+		const auto relocated = sourceArchetype.Erase( source.row );
+
+		if( relocated != Archetype::InvalidIndex )
+		{
+			m_objects.locations[relocated].row = source.row;
+			OnComponentsRelocated( relocated );
+		}
+	}
+
+	std::uint32_t World::GetOrCreateArchetype( const ComponentsMask& mask )
+	{
+		const auto found = m_archetypeLookup.find( mask );
+
+		if( found != m_archetypeLookup.end() )
+			return found->second;
+
+		const auto index = ( std::uint32_t )m_archetypes.size();
+		m_archetypes.push_back( std::make_unique< Archetype >( mask, m_components, m_memoryResource ) );
+		m_archetypeLookup.emplace( mask, index );
+		return index;
+	}
+
+	void World::OnComponentsRelocated( const std::uint32_t objectIndex )
+	{
+		const auto& location = m_objects.locations[objectIndex];
+		const auto& mask = m_objects.components[objectIndex];
+
+		mask.ForEachSetBit( [&]( const ComponentFamily family )
+		{
+			static_cast< Reflex::Components::BaseComponent* >( m_archetypes[location.archetype]->Get( family, location.row ) )->OnRelocated();
+		} );
 	}
 
 	sf::FloatRect World::GetBounds() const
@@ -364,20 +1443,24 @@ namespace Reflex::Core
 		return Object( m_sceneGraphRoot ).GetTransform();
 	}
 
-	void World::OnComponentAdded( const BaseObject& base )
+	void World::OnComponentAdded( const BaseObject& base, const ComponentFamily family )
 	{
 		const auto object = Object( base );
 		assert( IsValidObject( object ) );
 
-		// Here we want to check if we should add this component to any systems
-		for( const auto&[type, baseSystem] : m_systems )
+		UpdateViews( object.GetIndex() );
+
+		const auto& components = m_objects.components[object.GetIndex()];
+
+		// Only the systems observing the family can have started matching
+		// Indexed as a system's callback can add components, which may rebuild the observers
+		const auto& observers = GetComponentObservers( family );
+
+		for( std::size_t i = 0; i < observers.size(); ++i )
 		{
-			if( !baseSystem->ShouldAddObject( object ) )
-				continue;
+			auto* system = static_cast< Reflex::Systems::System* >( observers[i] );
 
-			auto* system = static_cast< Reflex::Systems::System* >( baseSystem.get() );
-			const auto found = Reflex::Find( system->m_releventObjects, object );
-			if( found != system->m_releventObjects.end() )
+			if( system->ContainsObject( object ) || !system->ShouldAddObject( object, components ) )
 				continue;
 
 			system->AddComponent( object ); 
@@ -385,23 +1468,38 @@ namespace Reflex::Core
 		}
 	}
 
-	void World::OnComponentRemoved( const BaseObject& base )
+	void World::OnComponentRemoved( const BaseObject& base, const ComponentFamily family )
 	{
 		const auto object = Object( base );
 
-		for( const auto& [type, baseSystem] : m_systems )
+		// Called before the component is destroyed, so test against the mask as it will be afterwards
+		auto components = m_objects.components[object.GetIndex()];
+		components.reset( family );
+
+		const auto& observers = GetComponentObservers( family );
+
+		for( std::size_t i = 0; i < observers.size(); ++i )
 		{
-			if( !baseSystem->ShouldAddObject( object ) )
-				continue;
+			auto* system = static_cast< Reflex::Systems::System* >( observers[i] );
 
-			auto* system = static_cast< Reflex::Systems::System* >( baseSystem.get() );
-			const auto found = Reflex::Find( system->m_releventObjects, object );
-			if( found == system->m_releventObjects.end() )
+			if( !system->ContainsObject( object ) || system->ShouldAddObject( object, components ) )
 				continue;
 
-			const auto toRemove = *found;
-			system->m_releventObjects.erase( found );
-			system->OnComponentRemoved( toRemove );
+			system->RemoveComponent( object );
+			system->OnComponentRemoved( object );
+		}
+	}
+
+	void World::UpdateViews( const std::uint32_t objectIndex )
+	{
+		const auto& components = m_objects.components[objectIndex];
+
+		for( auto& view : m_views )
+		{
+			if( components.Contains( view->mask ) )
+				view->objects.Insert( objectIndex );
+			else
+				view->objects.Erase( objectIndex );
 		}
 	}
 
@@ -451,9 +1549,9 @@ namespace Reflex::Core
 			Reflex::RandomFloat( margin, GetWindow().getSize().y - margin * 2.0f ) );
 	}
 
-	std::vector< Object > World::GetObjects()
+	FrameVector< Object > World::GetObjects()
 	{
-		std::vector< Object > output;
+		FrameVector< Object > output( &m_frameArena );
 		output.reserve( m_objects.flags.size() );
 
 		for( unsigned i = 1; i < m_objects.flags.size(); ++i )
@@ -465,27 +1563,34 @@ namespace Reflex::Core
 
 	World::RayCastResult World::RayCast( const sf::Vector2f& from, const sf::Vector2f& to )
 	{
+		// Only the closest hit is kept, so nothing is allocated per hit and it's safe to ray cast from multiple threads (box2d queries only read)
 		class RayCastCallback : public b2RayCastCallback {
 		public:
-			std::vector< RayCastResult > foundBodies;
+			RayCastCallback( const sf::Vector2f& from ) : from( from ) { }
+
+			const sf::Vector2f from;
+			std::optional< RayCastResult > closest;
+			float closestDistanceSq = 0.0f;
 
 			float ReportFixture( b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction ) final
 			{
 				const auto object = *(Object* )fixture->GetBody()->GetUserData();
-				foundBodies.push_back( RayCastResult( object, fixture, Reflex::B2VecToVector2f( point ), Reflex::B2VecToVector2f( normal ), fraction ) );
+				const auto distanceSq = Reflex::GetDistanceSq( object.GetTransform()->getPosition(), from );
+
+				if( !closest || distanceSq < closestDistanceSq )
+				{
+					closest.emplace( object, fixture, Reflex::B2VecToVector2f( point ), Reflex::B2VecToVector2f( normal ), fraction );
+					closestDistanceSq = distanceSq;
+				}
+
 				return true;
 			}
 		};
 
-		RayCastCallback callback;
+		RayCastCallback callback( from );
 		GetBox2DWorld().RayCast( &callback, Reflex::Vector2fToB2Vec( from ), Reflex::Vector2fToB2Vec( to ) );
 
-		const auto min = std::min_element( callback.foundBodies.begin(), callback.foundBodies.end(), [&from]( const auto& a, const auto& b )
-		{
-			return Reflex::GetDistanceSq( a.GetObject().GetTransform()->getPosition(), from ) < Reflex::GetDistanceSq( b.GetObject().GetTransform()->getPosition(), from );
-		} );
-
-		return min == callback.foundBodies.end() ? RayCastResult() : *min;
+		return callback.closest ? *callback.closest : RayCastResult();
 	}
 
 	World::RayCastResult::RayCastResult( Object object, b2Fixture* fixture, const sf::Vector2f& point, const sf::Vector2f& normal, const float fraction )
@@ -4,8 +4,14 @@
 #include "Context.h"
 #include "Systems/BaseSystem.h"
 #include "Memory/ComponentAllocator.h"
+#include "Memory/ArchetypeStorage.h"
+#include "Memory/SparseSet.h"
+#include "Memory/LinearArena.h"
 #include "EventManager.h"
 #include "TileMap.h"
+#include "RegionStreamer.h"
+#include "CommandBuffer.h"
+#include "Prefab.h"
 #include "Objects/BaseObject.h"
 #include "Components/Component.h"
 #include "Box2DDebugDraw.h"
@@ -24,11 +30,40 @@ namespace Reflex
 
 namespace Reflex::Core
 {
+	template< class... Ts >
+	class ComponentView;
+
 	// World class
 	class World : private sf::NonCopyable
 	{
 	public:
-		explicit World( const Context& context, const sf::FloatRect& worldBounds, const sf::Vector2f& gravity = sf::Vector2f( 0.0f, 9.8f ) );
+		// How component memory is laid out, chosen when the world is constructed
+		enum class StorageMode
+		{
+			SparseSet,	// One densely packed pool per component type (cheap add / remove)
+			Archetype,	// Objects with the same components are grouped into chunked arrays (fast iteration over multiple component types)
+		};
+
+		// Order in which the indices of destroyed objects are handed out again
+		enum class IndexReuse
+		{
+			LIFO,	// Most recently destroyed first (its data is most likely still in cache)
+			FIFO,	// Least recently destroyed first (spreads generation counter use over all indices)
+		};
+
+		struct ObjectMetrics
+		{
+			std::size_t live = 0;		// Objects currently alive
+			std::size_t free = 0;		// Destroyed object indices waiting to be reused
+			std::size_t peak = 0;		// Most objects alive at once
+			std::size_t capacity = 0;	// Object indices ever allocated (live + free + retired)
+			std::size_t reused = 0;		// Creations which recycled an index
+			std::size_t retired = 0;	// Indices which will never be reused because their generation counter ran out
+		};
+
+		// The memory resource backs the world's containers (object data, component storage, system object lists, tile map, event subscribers and scene graph children)
+		// It must outlive the world, eg. a std::pmr::monotonic_buffer_resource lets a short lived world be torn down by releasing a single buffer
+		explicit World( const Context& context, const sf::FloatRect& worldBounds, const sf::Vector2f& gravity = sf::Vector2f( 0.0f, 9.8f ), const StorageMode storageMode = StorageMode::SparseSet, std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource() );
 		~World();
 
 		void Update( const float deltaTime );
@@ -40,9 +75,62 @@ namespace Reflex::Core
 		Object CreateObject( const sf::Vector2f& position = {}, const float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f( 1.0f, 1.0f ), const bool attachToRoot = true, const bool useTileMap = true );
 		Object CreateObject( const std::string& objectFile, const sf::Vector2f& position = {}, const float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f( 1.0f, 1.0f ), const bool attachToRoot = true, const bool useTileMap = true );
 
+		// Batch version of CreateObject, object data and transforms are reserved once and the new objects are registered with systems / views in a single pass
+		// The new objects are appended to out
+		void CreateObjects( const std::size_t count, std::vector< Object >& out, const sf::Vector2f& position = {}, const float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f( 1.0f, 1.0f ), const bool attachToRoot = true, const bool useTileMap = true );
+		void CreateObjects( const std::vector< sf::Vector2f >& positions, std::vector< Object >& out, const float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f( 1.0f, 1.0f ), const bool attachToRoot = true, const bool useTileMap = true );
+
 		void DestroyObject( const BaseObject& object );
 		void DestroyAllObjects();
 
+		// Binary snapshot of every object (generations, components, scene graph and physics bodies), built in memory and written with a single sequential write
+		bool SaveSnapshot( const std::string& path ) const;
+
+		// Replaces every object with the ones in the snapshot, reading the file through a memory mapping and constructing each component type in bulk
+		// Indices and generations are restored, so handles taken before the snapshot was saved are valid again afterwards
+		// Returns false if the file can't be opened, throws if it isn't a valid snapshot
+		// A bad object table leaves the current world as it was, bad component data is only found once the world has been cleared and leaves it empty
+		bool LoadSnapshot( const std::string& path );
+
+		// Binary form of a set of objects and all their descendants (each with its components), used to stream regions in and out
+		// Parents are written before their children, parents outside the set are read back as the scene root
+		// Returns every object written, in the order they were written
+		std::vector< Object > WriteObjects( const std::vector< Object >& roots, SnapshotWriter& writer ) const;
+
+		// Creates the objects written by WriteObjects in a single pass, the scene graph is linked before construction completes
+		// Throws on invalid data, in which case no objects are added to out and the world is left as it was
+		void ReadObjects( SnapshotReader& reader, std::vector< Object >& out );
+
+		// Object files are compiled into a prefab the first time they are used (including through CreateObject), later calls return the cached prefab
+		const Prefab& GetPrefab( const std::string& objectFile );
+
+		// Creates objects from a prefab, placed by the transform values in its file (the new objects are appended to out)
+		Object Instantiate( const Prefab& prefab, const bool attachToRoot = true, const bool useTileMap = true );
+		void Instantiate( const Prefab& prefab, const std::size_t count, std::vector< Object >& out, const bool attachToRoot = true, const bool useTileMap = true );
+
+		void SetIndexReuse( const IndexReuse reuse ) { m_indexReuse = reuse; }
+		IndexReuse GetIndexReuse() const { return m_indexReuse; }
+		ObjectMetrics GetObjectMetrics() const;
+
+		// Time taken by each step of creating the world (registering each component type, adding each system which scans the existing objects etc.)
+		struct StartupTiming
+		{
+			std::string name;
+			sf::Time time;
+		};
+
+		const std::vector< StartupTiming >& GetStartupTimings() const { return m_startupTimings; }
+
+		// Releases memory that is no longer used by live objects (empty component chunks, unused sparse pages, spare archetype chunks)
+		// With defragment the components in each pool are also reordered by object index, which moves every component (same as a structural change)
+		// Returns the number of bytes released
+		std::size_t Compact( const bool defragment = false );
+
+		// Structural changes recorded here are applied at the sync points in Update (before and after the systems update) or by FlushCommands
+		// Systems should use their own BaseSystem::GetCommandBuffer, this one isn't safe to record into while a parallel stage is updating
+		CommandBuffer& GetCommandBuffer() { return m_commandBuffer; }
+		void FlushCommands();
+
 		bool IsValidObject( const BaseObject& object ) const;
 		bool IsObjectFlagSet( const BaseObject& object, const ObjectFlags flag ) const;
 		void SetObjectFlag( const BaseObject& object, const ObjectFlags flag );
@@ -56,6 +144,9 @@ namespace Reflex::Core
 		// The allocator must be already created (as in a component of the require type must already be registered or exist)
 		Reflex::Components::BaseComponent* ObjectAddEmptyComponent( const Object& object, const size_t family );
 
+		// Adds a copy of a prototype component (see Prefab), the family's type must be copyable
+		Reflex::Components::BaseComponent* ObjectAddComponentCopy( const Object& object, const ComponentFamily family, const void* prototype );
+
 		template< class T >
 		T* ObjectGetComponent( const BaseObject& object ) const;
 
@@ -76,8 +167,34 @@ namespace Reflex::Core
 		bool ObjectHasComponent( const BaseObject& object, const size_t family ) const;
 
 		// Returns true if the register resulted in a new component being allocated
+		// Chunk bytes is the size of each block of components in the pool (large pools may want to match the OS large page size), it is ignored if the type is already registered
+		template< class T >
+		bool RegisterComponent( const std::size_t chunkBytes = ComponentAllocatorBase::DefaultChunkBytes );
+
+		// Iterates the densely packed storage of a component type directly (no per object lookup)
+		// Components of type T must not be added or removed from within the callback
+		template< class T, typename Func >
+		void ForEachComponent( Func function );
+
+		// Calls function( Ts&... ) for every object that has all of the component types
+		// In archetype mode this only walks the chunks of matching archetypes, no components may be added or removed from within the callback
+		template< class... Ts, typename Func >
+		void ForEachMatching( Func function );
+
+		// Returns a cached view of every object that has all of the component types
+		// The view is built on first use and then kept up to date as components are added / removed, rather than matched each frame
+		template< class... Ts >
+		ComponentView< Ts... > View();
+
+		// Direct component access by object index with no validity checks (used by views to iterate without handles)
 		template< class T >
-		bool RegisterComponent();
+		T& GetComponentUnchecked( const std::uint32_t objectIndex );
+
+		// Incremented whenever components are added / removed or objects destroyed (anything that can move or invalidate component memory)
+		std::uint32_t GetStructuralVersion() const { return m_structuralVersion; }
+
+		StorageMode GetStorageMode() const { return m_storageMode; }
+		std::size_t GetArchetypeCount() const { return m_archetypes.size(); }
 		/*---------------*/
 
 		/* System functions*/
@@ -87,8 +204,23 @@ namespace Reflex::Core
 		template< class T >
 		T* GetSystem();
 
+		// Systems grouped into stages which update one after another, the systems within a stage don't conflict and update in parallel
+		// Systems are placed in the earliest stage after every system added before them that they conflict with, so the result only depends on the order systems were added
+		const std::vector< std::vector< Reflex::Systems::BaseSystem* > >& GetSchedule();
+
 		template< class T >
 		void RemoveSystem();
+
+		// Systems observing a family are asked whether an object still matches whenever a component of that family is added to / removed from it
+		// Rebuilt on demand after systems are added / removed or InvalidateObservers is called, in the order the systems were added
+		const std::vector< Reflex::Systems::BaseSystem* >& GetComponentObservers( const ComponentFamily family );
+		void InvalidateObservers() { m_observersDirty = true; }
+
+		// Families whose type is a render component, flagged when the type is registered
+		const ComponentsMask& GetRenderComponents() const { return m_renderComponents; }
+
+		// Reflection table of a registered component type, null if the type isn't reflected (see Component::GetTypeInfo)
+		const Core::TypeInfo* GetComponentTypeInfo( const ComponentFamily family ) const { return family < m_componentTypeInfo.size() ? m_componentTypeInfo[family] : nullptr; }
 		/*---------------*/
 
 		// Utility and helper functions
@@ -99,16 +231,21 @@ namespace Reflex::Core
 		TextureManager& GetTextureManager() { return m_context.textureManager; }
 		FontManager& GetFontManager() { return m_context.fontManager; }
 		EventManager& GetEventManager() { return eventManager; }
+		std::pmr::memory_resource* GetMemoryResource() const { return m_memoryResource; }
 		TileMap& GetTileMap() { return m_tileMap; }
 		const TileMap& GetTileMap() const { return m_tileMap; }
+
+		// Streams tile map aligned regions of objects in and out of memory, disabled until a region directory is set
+		RegionStreamer& GetRegionStreamer() { return m_regionStreamer; }
+		const RegionStreamer& GetRegionStreamer() const { return m_regionStreamer; }
 		b2World& GetBox2DWorld() { return *m_box2DWorld; }
 		const b2World& GetBox2DWorld() const { return *m_box2DWorld; }
 
 		sf::FloatRect GetBounds() const;
 		Reflex::Handle< Reflex::Components::Transform > GetSceneRoot() const;
 
-		void OnComponentAdded( const BaseObject& object );
-		void OnComponentRemoved( const BaseObject& object );
+		void OnComponentAdded( const BaseObject& object, const ComponentFamily family );
+		void OnComponentRemoved( const BaseObject& object, const ComponentFamily family );
 
 		bool IsActiveCamera( const Reflex::Handle< Reflex::Components::Camera >& camera ) const;
 		void SetActiveCamera( const Reflex::Handle< Reflex::Components::Camera >& camera );
@@ -120,7 +257,19 @@ namespace Reflex::Core
 		sf::Vector2f GetWindowCentre() const { return Reflex::Vector2iToVector2f( GetWindow().getPosition() ) + GetWindowSize() / 2.0f; }
 		sf::Vector2f GetWindowSize() const { return Reflex::Vector2uToVector2f( GetWindow().getSize() ); }
 
-		std::vector< Object > GetObjects();
+		// Allocated from the frame arena, so the result must not be kept past the end of the current update / render
+		FrameVector< Object > GetObjects();
+
+		// Scratch memory for transient allocations, reset at the end of every Update and Render
+		LinearArena& GetFrameArena() { return m_frameArena; }
+
+		// Change tracking, the tick advances at the start of every system stage (and once after the last) so a change is stamped with the stage it happened in
+		// A system can then tell its own changes apart from changes made since it last updated (see System::ForEachChangedObject)
+		std::uint32_t GetChangeTick() const { return m_changeTick; }
+		void MarkComponentChanged( const ComponentFamily family ) { m_componentChangeTicks[family].store( m_changeTick, std::memory_order_relaxed ); }
+
+		// Whether any component of the family has changed after the tick, so systems can skip the type entirely
+		bool ComponentChangedSince( const ComponentFamily family, const std::uint32_t tick ) const { return std::int32_t( m_componentChangeTicks[family].load( std::memory_order_relaxed ) - tick ) > 0; }
 
 		float GetBox2DUnitToPixelScale() const { return m_box2DUnitToPixelScale; }
 		float ToBox2DUnits( const float worldUnits ) const { return worldUnits / m_box2DUnitToPixelScale; }
@@ -146,15 +295,60 @@ namespace Reflex::Core
 
 	protected:
 		void Setup();
+
+		template< typename Func >
+		void TimeStartupStep( const std::string& name, Func step );
+
+		template< class... Ts >
+		void RegisterStartupComponents();
+
+		template< class... Ts >
+		void AddStartupSystems();
 		Object ObjectFromIndex( const unsigned index );
 
+		// Takes an index from the free list according to the reuse policy, the free list must not be empty
+		std::uint32_t PopFreeIndex();
+		void OnObjectsCreated( const std::size_t count );
+
+		// Marks the object deleted and returns its index to the free list (or retires it), its components must already be gone
+		void ReleaseObjectIndex( const std::uint32_t index );
+
+		// Destroys objects[first..] whose components were constructed but never completed construction (so no callbacks are made), used to undo a failed read
+		void DiscardUnconstructedObjects( const std::vector< Object >& objects, const std::size_t first );
+		void DiscardUnconstructedComponents( const std::uint32_t index );
+
+		// Shared implementation of the CreateObjects functions, position i is positions[i * positionStride] (so a stride of 0 gives every object the same position)
+		void CreateObjects( const sf::Vector2f* positions, const std::size_t positionStride, const std::size_t count, std::vector< Object >& out, const float rotation, const sf::Vector2f& scale, const bool attachToRoot, const bool useTileMap );
+
 		bool IsObjectFlagSet( const std::uint32_t objectIndex, const ObjectFlags flag ) const;
 		void SetObjectFlag( const std::uint32_t objectIndex, const ObjectFlags flag );
 
+		// Archetype storage, moves the object to the archetype for the new mask and returns the (unconstructed) memory for the new component
+		void* ArchetypeAddComponent( const BaseObject& object, const ComponentFamily family );
+		void ArchetypeMoveObject( const std::uint32_t objectIndex, const ComponentsMask& newMask );
+		std::uint32_t GetOrCreateArchetype( const ComponentsMask& mask );
+		void OnComponentsRelocated( const std::uint32_t objectIndex );
+
+		void UpdateViews( const std::uint32_t objectIndex );
+
+		void BuildSchedule();
+		void BuildObservers();
+
+		// Adds the prefab's components (other than the transform) to an object created for it
+		void ApplyPrefab( const Prefab& prefab, const Object& object );
+		void UpdateSystems( const float deltaTime );
+		void UpdateStageSystem( Reflex::Systems::BaseSystem& system, CommandBuffer& commandBuffer, const float deltaTime );
+
 	private:
 		World() = delete;
 
 	protected:
+		sf::Clock m_startupClock;
+		std::vector< StartupTiming > m_startupTimings;
+
+		// Declared before every container that allocates from it
+		std::pmr::memory_resource* m_memoryResource = nullptr;
+
 		Context m_context;
 		sf::View m_worldView;
 		sf::FloatRect m_worldBounds;
@@ -174,30 +368,110 @@ namespace Reflex::Core
 
 		// Tilemap which stores object handles in the world in an efficient spacial hash map
 		TileMap m_tileMap;
+		RegionStreamer m_regionStreamer;
+
+		// Deferred structural changes
+		CommandBuffer m_commandBuffer;
+
+		LinearArena m_frameArena;
+
+		// Ticks are compared with wrap around, so only the difference between two ticks matters
+		std::uint32_t m_changeTick = 1;
+
+		// Last tick each component family was changed in, atomic as systems in a parallel stage may mark the same family
+		std::array< std::atomic< std::uint32_t >, MaxComponents > m_componentChangeTicks{};
 
 		// Object data
+		struct ArchetypeLocation
+		{
+			std::uint32_t archetype = Archetype::InvalidIndex;
+			std::uint32_t row = 0;
+		};
+
 		struct ObjectData
 		{
+			explicit ObjectData( std::pmr::memory_resource* resource ) : flags( resource ), components( resource ), counters( resource ), locations( resource ) { }
+
 			// Separate vectors are more efficient for fast lookup for individual data (less data to pull into cache), we rarely need info from more than 1 at the same time
-			std::vector< std::bitset< ( size_t )ObjectFlags::NumFlags > > flags;
-			std::vector< ComponentsMask > components;
-			std::vector< unsigned > counters;
+			std::pmr::vector< std::bitset< ( size_t )ObjectFlags::NumFlags > > flags;
+			std::pmr::vector< ComponentsMask > components;
+			std::pmr::vector< unsigned > counters;
+			std::pmr::vector< ArchetypeLocation > locations;
 		};
 
 		ObjectData m_objects;
 
-		// Storage for all components
-		std::vector< std::unique_ptr< ComponentAllocatorBase > > m_components;
+		// Storage for all components (in archetype mode the allocators only describe the types, the components live in the archetypes)
+		const StorageMode m_storageMode;
+		std::pmr::vector< std::unique_ptr< ComponentAllocatorBase > > m_components;
+		std::vector< const Core::TypeInfo* > m_componentTypeInfo;
+		std::pmr::vector< std::unique_ptr< Archetype > > m_archetypes;
+		std::unordered_map< ComponentsMask, std::uint32_t > m_archetypeLookup;
+
+		// Compiled object files by path, after the allocators so the prototypes are destroyed first
+		std::unordered_map< std::string, std::unique_ptr< Prefab > > m_prefabs;
+
+		// Cached views, each holds the set of objects matching its mask
+		struct CachedView
+		{
+			ComponentsMask mask;
+			SparseSet objects;
+		};
+
+		std::vector< std::unique_ptr< CachedView > > m_views;
+
+		std::uint32_t m_structuralVersion = 1;
 		std::unordered_map< std::string, size_t > m_componentNameToIndex;
-		std::queue< unsigned > m_freeList;
+
+		// Destroyed object indices, their generation counter has already been bumped so old handles to them are invalid
+		std::pmr::deque< std::uint32_t > m_freeList;
+		IndexReuse m_indexReuse = IndexReuse::LIFO;
+		ObjectMetrics m_objectMetrics;
 
 		// List of systems, indexed by their type, storage for all systems
 		std::unordered_map< Type, std::unique_ptr< Reflex::Systems::BaseSystem > > m_systems;
 
+		// Systems in the order they were added, everything that runs every system goes through this (or the schedule) so the order is deterministic
+		std::vector< Reflex::Systems::BaseSystem* > m_systemOrder;
+		std::vector< std::vector< Reflex::Systems::BaseSystem* > > m_schedule;
+		bool m_scheduleDirty = true;
+		std::array< std::vector< Reflex::Systems::BaseSystem* >, MaxComponents > m_componentObservers;
+		bool m_observersDirty = true;
+		ComponentsMask m_renderComponents;
+		std::vector< CommandBuffer > m_stageCommandBuffers;
+
 		BaseObject m_sceneGraphRoot;
 		BaseObject m_activeCamera;
 	};
 
+	// Typed iteration over a cached set of objects, see World::View
+	// Gives direct references to the components, so components of the viewed types must not be added or removed while iterating
+	template< class... Ts >
+	class ComponentView
+	{
+	public:
+		ComponentView( World& world, const SparseSet& objects )
+			: m_world( world )
+			, m_objects( objects )
+		{
+		}
+
+		template< typename Func >
+		void ForEach( Func function ) const
+		{
+			for( const auto index : m_objects )
+				function( m_world.template GetComponentUnchecked< Ts >( index )... );
+		}
+
+		std::size_t Size() const { return m_objects.Size(); }
+		bool Empty() const { return m_objects.Empty(); }
+		const SparseSet& GetObjects() const { return m_objects; }
+
+	private:
+		World& m_world;
+		const SparseSet& m_objects;
+	};
+
 	// Template functions
 	template< class T, typename... Args >
 	T* World::ObjectAddComponent( const BaseObject& object, Args&& ... args )
@@ -212,28 +486,34 @@ namespace Reflex::Core
 		}
 
 		// Create allocator for this component type if it is new (usually this is done via the RegisterComponent< T > function)
-		if( family >= m_components.size() )
-		{
-			assert( family == m_components.size() );
-			m_components.push_back( std::unique_ptr< ComponentAllocatorBase >( new ComponentAllocator< T >( std::max( 128U, object.GetIndex() ) ) ) );
-		}
-		else
-			m_components[family]->ExpandToFit( object.GetIndex() + 1 );
+		RegisterComponent< T >();
 
 		// Allocate memory and construct, passing args through
-		auto* allocator = static_cast< ComponentAllocator< T >* >( m_components[family].get() );
-		auto newComponent = static_cast< T* >( allocator->Construct( object.GetIndex(), object, std::forward<Args>( args )... ) );
+		T* newComponent = nullptr;
+
+		if( m_storageMode == StorageMode::Archetype )
+			newComponent = new( ArchetypeAddComponent( object, family ) ) T( object, std::forward<Args>( args )... );
+		else
+			newComponent = static_cast< ComponentAllocator< T >* >( m_components[family].get() )->Construct( object.GetIndex(), object, std::forward<Args>( args )... );
+
 		m_objects.components[object.GetIndex()].set( family );
+		++m_structuralVersion;
 
 		const auto requiredComponents = T::GetRequiredComponents();
 
 		// Automatically add required components
-		for( unsigned i = 0; i < MaxComponents; ++i )
-			if( requiredComponents.test( i ) && !m_objects.components[object.GetIndex()].test( i ) )
+		requiredComponents.ForEachSetBit( [&]( const ComponentFamily i )
+		{
+			if( !m_objects.components[object.GetIndex()].test( i ) )
 				ObjectAddEmptyComponent( object, i );
+		} );
+
+		// Adding the required components will have moved the object to another archetype
+		if( m_storageMode == StorageMode::Archetype && requiredComponents.any() )
+			newComponent = ObjectGetComponent< T >( object );
 
 		newComponent->OnConstructionComplete();
-		OnComponentAdded( object );
+		OnComponentAdded( object, family );
 
 		return newComponent;
 	}
@@ -253,22 +533,130 @@ namespace Reflex::Core
 	template< class T >
 	bool World::ObjectHasComponent( const BaseObject& object ) const
 	{
-		return ObjectHasComponent( object, ( size_t )T::GetFamily() );
+		return m_objects.components[object.GetIndex()].test( T::GetFamily() );
 	}
 
 	template< class T >
-	bool World::RegisterComponent()
+	bool World::RegisterComponent( const std::size_t chunkBytes /*= ComponentAllocatorBase::DefaultChunkBytes*/ )
 	{
 		const auto family = T::GetFamily();
 
+		// Families are assigned during static initialisation, so they can be registered in any order
 		if( family >= m_components.size() )
 		{
-			assert( family == m_components.size() );
-			m_componentNameToIndex[T::GetComponentName()] = m_components.size();
-			m_components.push_back( std::unique_ptr< ComponentAllocatorBase >( new ComponentAllocator< T >( 128 ) ) );
-			return true;
+			m_components.resize( family + 1 );
+			m_componentTypeInfo.resize( family + 1 );
 		}
-		return false;
+
+		if( m_components[family] )
+			return false;
+
+		m_componentNameToIndex[T::GetComponentName()] = family;
+		m_components[family] = std::unique_ptr< ComponentAllocatorBase >( new ComponentAllocator< T >( chunkBytes, m_memoryResource ) );
+
+		if constexpr( T::IsReflected() )
+			m_componentTypeInfo[family] = &T::GetTypeInfo();
+
+		if constexpr( T::IsRenderComponent )
+		{
+			m_renderComponents.set( family );
+			m_observersDirty = true;
+		}
+
+		return true;
+	}
+
+	template< class T, typename Func >
+	void World::ForEachComponent( Func function )
+	{
+		const auto family = T::GetFamily();
+
+		if( family >= m_components.size() || !m_components[family] )
+			return;
+
+		if( m_storageMode == StorageMode::Archetype )
+			ForEachMatching< T >( function );
+		else
+			static_cast< ComponentAllocator< T >* >( m_components[family].get() )->ForEach( function );
+	}
+
+	template< class... Ts, typename Func >
+	void World::ForEachMatching( Func function )
+	{
+		ComponentsMask required;
+		( required.set( Ts::GetFamily() ), ... );
+
+		if( m_storageMode == StorageMode::Archetype )
+		{
+			for( auto& archetype : m_archetypes )
+			{
+				if( !archetype->GetMask().Contains( required ) )
+					continue;
+
+				for( std::size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk )
+				{
+					const auto count = archetype->GetChunkSize( chunk );
+					const auto columns = std::make_tuple( archetype->template GetColumn< Ts >( Ts::GetFamily(), chunk )... );
+
+					for( std::uint32_t row = 0; row < count; ++row )
+						function( std::get< Ts* >( columns )[row]... );
+				}
+			}
+
+			return;
+		}
+
+		// Sparse sets: walk the pool of the first type and look the rest up
+		const auto family = std::tuple_element_t< 0, std::tuple< Ts... > >::GetFamily();
+
+		if( family >= m_components.size() || !m_components[family] )
+			return;
+
+		const auto& entities = m_components[family]->GetEntities();
+
+		for( std::size_t slot = 0; slot < entities.size(); ++slot )
+		{
+			const auto index = entities[slot];
+
+			if( m_objects.components[index].Contains( required ) )
+				function( *static_cast< Ts* >( m_components[Ts::GetFamily()]->Get( index ) )... );
+		}
+	}
+
+	template< class... Ts >
+	ComponentView< Ts... > World::View()
+	{
+		static_assert( sizeof...( Ts ) > 0, "A view requires at least one component type" );
+		( RegisterComponent< Ts >(), ... );
+
+		ComponentsMask mask;
+		( mask.set( Ts::GetFamily() ), ... );
+
+		for( const auto& view : m_views )
+			if( view->mask == mask )
+				return ComponentView< Ts... >( *this, view->objects );
+
+		auto view = std::make_unique< CachedView >();
+		view->mask = mask;
+
+		for( std::uint32_t i = 0; i < m_objects.components.size(); ++i )
+			if( m_objects.components[i].Contains( mask ) )
+				view->objects.Insert( i );
+
+		m_views.push_back( std::move( view ) );
+		return ComponentView< Ts... >( *this, m_views.back()->objects );
+	}
+
+	template< class T >
+	T& World::GetComponentUnchecked( const std::uint32_t objectIndex )
+	{
+		if( m_storageMode == StorageMode::Archetype )
+		{
+			const auto& location = m_objects.locations[objectIndex];
+			return *static_cast< T* >( m_archetypes[location.archetype]->Get( T::GetFamily(), location.row ) );
+		}
+
+		return *static_cast< ComponentAllocator< T >* >( m_components[T::GetFamily()].get() )->Get( objectIndex );
 	}
 
 	template< class T, typename... Args >
@@ -283,6 +671,7 @@ namespace Reflex::Core
 		}
 
 		auto system = std::make_unique< T >( *this, std::forward< Args >( args )... );
+		system->m_commandBuffer = &m_commandBuffer;
 
 		// Register components
 		system->RegisterComponents();
@@ -293,7 +682,7 @@ namespace Reflex::Core
 			if( IsObjectFlagSet( i, ObjectFlags::Deleted ) )
 				continue;
 
-			if( !system->ShouldAddObject( ObjectFromIndex( i ) ) )
+			if( !system->ShouldAddObject( ObjectFromIndex( i ), m_objects.components[i] ) )
 				continue;
 
 			system->AddComponent( ObjectFromIndex( i ) );
@@ -303,6 +692,10 @@ namespace Reflex::Core
 		auto result = m_systems.insert( std::make_pair( type, std::move( system ) ) );
 		assert( result.second );
 
+		m_systemOrder.push_back( result.first->second.get() );
+		m_scheduleDirty = true;
+		m_observersDirty = true;
+
 		result.first->second->OnSystemStartup();
 
 		return ( T* )result.first->second.get();
@@ -318,6 +711,9 @@ namespace Reflex::Core
 			if( systemType == iter->first )
 			{
 				iter->second->OnSystemShutdown();
+				Reflex::Erase( m_systemOrder, iter->second.get() );
+				m_scheduleDirty = true;
+				m_observersDirty = true;
 				iter->second.release();
 				m_systems.erase( iter );
 				break;
@@ -325,6 +721,26 @@ namespace Reflex::Core
 		}
 	}
 
+	template< typename Func >
+	void World::TimeStartupStep( const std::string& name, Func step )
+	{
+		const sf::Clock clock;
+		step();
+		m_startupTimings.push_back( { name, clock.getElapsedTime() } );
+	}
+
+	template< class... Ts >
+	void World::RegisterStartupComponents()
+	{
+		( TimeStartupStep( "Register " + std::string( Ts::GetComponentName() ), [this]() { RegisterComponent< Ts >(); } ), ... );
+	}
+
+	template< class... Ts >
+	void World::AddStartupSystems()
+	{
+		( TimeStartupStep( std::string( "Add " ) + typeid( Ts ).name(), [this]() { AddSystem< Ts >(); } ), ... );
+	}
+
 	template< class T >
 	T* World::GetSystem()
 	{
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "ComponentAllocator.h"
+
+namespace Reflex::Core
+{
+	// Archetype storage (chunked structure of arrays)
+	// Every object with the same components mask lives in the same archetype, which stores its objects in fixed size chunks
+	// Within a chunk each component type is its own tightly packed array, so a query only streams the arrays it needs from the archetypes that match
+	// Rows are kept packed (removing a row moves the last row into the hole), the allocators are only used as type descriptors to construct / move / destroy components
+	class Archetype
+	{
+	public:
+		static constexpr std::uint32_t InvalidIndex = ComponentAllocatorBase::InvalidIndex;
+		static constexpr std::size_t ChunkBytes = 16 * 1024;
+		static constexpr std::size_t MinColumnAlignment = alignof( std::max_align_t );
+
+		// Chunks are allocated from the given memory resource
+		Archetype( const ComponentsMask& mask, const std::pmr::vector< std::unique_ptr< ComponentAllocatorBase > >& types, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+			: mask( mask )
+			, resource( resource )
+		{
+			columnLookup.fill( InvalidIndex );
+
+			std::size_t rowBytes = 0;
+
+			for( ComponentFamily family = 0; family < MaxComponents; ++family )
+			{
+				if( !mask.test( family ) )
+					continue;
+
+				assert( family < types.size() && types[family] );
+				columnLookup[family] = ( std::uint32_t )columns.size();
+				columns.push_back( { types[family].get(), family, 0 } );
+				rowBytes += types[family]->GetElementSize();
+				chunkAlignment = std::max( chunkAlignment, types[family]->GetAlignment() );
+			}
+
+			// Round the rows per chunk down to a power of two so a row is located with a shift and mask
+			const auto rowsPerChunk = std::max( std::size_t( 1 ), ChunkBytes / std::max( std::size_t( 1 ), rowBytes ) );
+			while( ( std::size_t( 2 ) << chunkShift ) <= rowsPerChunk )
+				++chunkShift;
+			chunkCapacity = 1U << chunkShift;
+			chunkMask = chunkCapacity - 1;
+
+			// Lay the columns out one after another within a chunk, each starting at its type's alignment
+			for( auto& column : columns )
+			{
+				column.offset = AlignUp( chunkBytes, column.type->GetAlignment() );
+				chunkBytes = column.offset + column.type->GetElementSize() * chunkCapacity;
+			}
+		}
+
+		const ComponentsMask& GetMask() const { return mask; }
+		std::size_t GetCount() const { return entities.size(); }
+		std::size_t GetChunkCount() const { return chunks.size(); }
+		std::uint32_t GetChunkCapacity() const { return chunkCapacity; }
+		bool HasColumn( const ComponentFamily family ) const { return columnLookup[family] != InvalidIndex; }
+
+		// Number of used rows in the given chunk
+		std::uint32_t GetChunkSize( const std::size_t chunk ) const
+		{
+			assert( chunk < chunks.size() );
+			const auto first = chunk << chunkShift;
+			return first >= entities.size() ? 0U : ( std::uint32_t )std::min( entities.size() - first, std::size_t( chunkCapacity ) );
+		}
+
+		// Entity index owning each row of a chunk
+		const std::uint32_t* GetChunkEntities( const std::size_t chunk ) const
+		{
+			return entities.data() + ( chunk << chunkShift );
+		}
+
+		std::uint32_t GetEntity( const std::uint32_t row ) const
+		{
+			assert( row < entities.size() );
+			return entities[row];
+		}
+
+		// Start of the array for the component family in a chunk
+		template< typename T >
+		T* GetColumn( const ComponentFamily family, const std::size_t chunk )
+		{
+			assert( HasColumn( family ) && chunk < chunks.size() );
+			return reinterpret_cast< T* >( chunks[chunk].get() + columns[columnLookup[family]].offset );
+		}
+
+		void* Get( const ComponentFamily family, const std::uint32_t row )
+		{
+			assert( HasColumn( family ) && row < entities.size() );
+			return GetRowAddress( columns[columnLookup[family]], row );
+		}
+
+		// Appends a row for the entity, the component memory is left uninitialised
+		std::uint32_t Allocate( const std::uint32_t index )
+		{
+			const auto row = ( std::uint32_t )entities.size();
+
+			if( ( row >> chunkShift ) >= chunks.size() )
+				chunks.emplace_back( AllocateChunk() );
+
+			entities.push_back( index );
+			return row;
+		}
+
+		// Moves the components of a row that also exist in the destination archetype into its row
+		// Components that don't exist in the destination must already have been destroyed, the source row is left to be erased with Erase
+		void MoveRow( const std::uint32_t row, Archetype& destination, const std::uint32_t destinationRow )
+		{
+			for( const auto& column : columns )
+				if( destination.HasColumn( column.family ) )
+					column.type->RelocateAt( destination.Get( column.family, destinationRow ), Get( column.family, row ) );
+		}
+
+		// Removes a row whose components have already been destroyed or moved out, the last row is moved into the hole
+		// Returns the entity index of the row that was relocated (or InvalidIndex if nothing moved)
+		std::uint32_t Erase( const std::uint32_t row )
+		{
+			assert( row < entities.size() );
+			const auto last = ( std::uint32_t )entities.size() - 1;
+			auto relocated = InvalidIndex;
+
+			if( row != last )
+			{
+				relocated = entities[last];
+
+				for( const auto& column : columns )
+					column.type->RelocateAt( GetRowAddress( column, row ), GetRowAddress( column, last ) );
+
+				entities[row] = relocated;
+			}
+
+			entities.pop_back();
+
+			// Keep one spare chunk around to avoid thrashing when an entity moves back and forth on a chunk boundary
+			while( chunks.size() > ( ( entities.size() + chunkMask ) >> chunkShift ) + 1 )
+				chunks.pop_back();
+
+			return relocated;
+		}
+
+		// Releases the spare chunk kept by Erase, returns the number of bytes released
+		std::size_t Shrink()
+		{
+			const auto needed = ( entities.size() + chunkMask ) >> chunkShift;
+			const auto released = ( chunks.size() - needed ) * chunkBytes;
+			chunks.erase( chunks.begin() + needed, chunks.end() );
+			chunks.shrink_to_fit();
+			entities.shrink_to_fit();
+			return released;
+		}
+
+	private:
+		struct Column;
+
+		char* GetRowAddress( const Column& column, const std::uint32_t row ) const
+		{
+			return chunks[row >> chunkShift].get() + column.offset + ( row & chunkMask ) * column.type->GetElementSize();
+		}
+
+		static std::size_t AlignUp( const std::size_t bytes, const std::size_t alignment )
+		{
+			return ( bytes + alignment - 1 ) & ~( alignment - 1 );
+		}
+
+		struct ChunkDeleter
+		{
+			std::pmr::memory_resource* resource;
+			std::size_t bytes;
+			std::size_t alignment;
+			void operator()( char* chunk ) const { resource->deallocate( chunk, bytes, alignment ); }
+		};
+
+		typedef std::unique_ptr< char, ChunkDeleter > Chunk;
+
+		Chunk AllocateChunk() const
+		{
+			// Aligned to the most aligned column type so over-aligned components are placed correctly
+			const auto bytes = std::max( chunkBytes, chunkAlignment );
+			return Chunk( static_cast< char* >( resource->allocate( bytes, chunkAlignment ) ), ChunkDeleter{ resource, bytes, chunkAlignment } );
+		}
+
+		struct Column
+		{
+			ComponentAllocatorBase* type = nullptr;
+			ComponentFamily family = 0;
+			std::size_t offset = 0;
+		};
+
+		ComponentsMask mask;
+		std::pmr::memory_resource* resource = nullptr;
+		std::vector< Column > columns;
+		std::array< std::uint32_t, MaxComponents > columnLookup;
+		std::vector< Chunk > chunks;
+		std::vector< std::uint32_t > entities;
+		std::uint32_t chunkCapacity = 1;
+		std::uint32_t chunkShift = 0;
+		std::uint32_t chunkMask = 0;
+		std::size_t chunkBytes = 0;
+		std::size_t chunkAlignment = MinColumnAlignment;
+	};
+}
\ No newline at end of file
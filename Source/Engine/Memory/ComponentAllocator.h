@@ -1,117 +1,353 @@
 #pragma once
 
+#include "SparseSet.h"
+
+#include <memory_resource>
+
+namespace Reflex { class Object; }
+
 namespace Reflex::Core
 {
+	// Sparse set component pool
+	// Entity indices map through a paged sparse array into a densely packed array of components (plus a dense list of the owning entity indices)
+	// Memory scales with the number of live components rather than the number of entities, and the dense array can be iterated linearly
+	// Removing a component moves the last component into the freed slot, so raw component pointers are only stable until the next removal from the same pool
 	class ComponentAllocatorBase
 	{
 	public:
-		ComponentAllocatorBase( const std::size_t count, const std::size_t elementSize, const std::size_t chunkSize = 8192 )
-			: chunkSize( chunkSize )
+		static constexpr std::uint32_t InvalidIndex = SparseIndex::InvalidIndex;
+		static constexpr std::size_t DefaultChunkBytes = 64 * 1024;
+
+		// Chunks are sized by a byte budget, holding the largest power of two number of elements that fits (at least one)
+		// Power of two so locating a slot is a shift and mask rather than a divide
+		// Chunks (other than large page ones) and the dense array are allocated from the given memory resource
+		ComponentAllocatorBase( const std::size_t elementSize, const std::size_t elementAlignment, const std::size_t chunkBytes = DefaultChunkBytes, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+			: resource( resource )
+			, dense( resource )
 			, elementSize( elementSize )
+			, alignment( std::max( elementAlignment, alignof( std::max_align_t ) ) )
+			, chunkSize( std::size_t( 1 ) << Log2( std::max( std::size_t( 1 ), chunkBytes / elementSize ) ) )
+			, chunkShift( Log2( chunkSize ) )
+			, chunkMask( chunkSize - 1 )
+		{
+			// sizeof is always a multiple of alignof, so aligning the chunk (to at least the element's alignment) aligns every element in it
+			assert( elementSize % elementAlignment == 0 );
+		}
+
+		virtual ~ComponentAllocatorBase()
 		{
-			ExpandToFit( count );
+			while( !data.empty() )
+				FreeLastChunk();
 		}
 
-		~ComponentAllocatorBase()
+		// Chunks of at least the large page size are backed by large pages once enabled (falling back to normal allocation if that fails)
+		// Returns false if the process doesn't have the privilege to use them
+		static bool EnableLargePages()
 		{
-			for( auto& chunk : data )
-				delete[] chunk;
-			data.clear();
+			s_largePageSize = EnableLargePagePrivilege() ? GetLargePageMinimum() : 0;
+			return s_largePageSize != 0;
 		}
 
 		std::size_t GetCapacity() const { return capacity; }
-		std::size_t GetCount() const { return count; }
+		std::size_t GetCount() const { return dense.size(); }
 		std::size_t GetChunkCount() const { return data.size(); }
 		std::size_t GetElementSize() const { return elementSize; }
 		std::size_t GetChunkSize() const { return chunkSize; }
+		std::size_t GetChunkBytes() const { return elementSize * chunkSize; }
+		std::size_t GetAlignment() const { return alignment; }
+
+		// Dense list of entity indices, entity at position i owns the component returned by GetDense( i )
+		const std::pmr::vector< std::uint32_t >& GetEntities() const { return dense; }
 
 		void Reserve( const std::size_t num )
 		{
-			while( num >= capacity )
+			while( num > capacity )
 				Append();
 		}
 
-		void Resize( const std::size_t num )
+		void Append()
 		{
-			count = num;
+			data.emplace_back( AllocateChunk() );
+			capacity += chunkSize;
 		}
 
-		void ExpandToFit( const std::size_t num )
+		// Releases the chunks past the last live component and any unused sparse pages, returns the number of bytes released
+		std::size_t Shrink()
 		{
-			if( num > count ) 
+			const auto needed = ( dense.size() + chunkSize - 1 ) >> chunkShift;
+			std::size_t released = sparse.Shrink();
+
+			while( data.size() > needed )
 			{
-				if( num >= capacity ) 
-					Reserve( num );
-				count = num;
+				FreeLastChunk();
+				released += GetChunkBytes();
 			}
+
+			data.shrink_to_fit();
+			dense.shrink_to_fit();
+			return released;
 		}
 
-		void Append()
+		// Relocates the components so the dense array is in entity index order, which removal (back filling holes) scrambles over time
+		// Returns false if it was already in order, otherwise every component has moved and the caller must let them know
+		bool SortByEntity()
 		{
-			data.emplace_back( new char[elementSize * chunkSize] );
-			capacity += chunkSize;
+			if( std::is_sorted( dense.begin(), dense.end() ) )
+				return false;
+
+			std::vector< std::uint32_t > order( dense.size() );
+			for( std::uint32_t slot = 0; slot < order.size(); ++slot )
+				order[slot] = slot;
+			std::sort( order.begin(), order.end(), [this]( const std::uint32_t a, const std::uint32_t b ) { return dense[a] < dense[b]; } );
+
+			// Sort into freshly allocated chunks, then swap them in and free the old ones
+			const auto chunks = data.size();
+			for( std::size_t i = 0; i < chunks; ++i )
+				Append();
+
+			std::pmr::vector< std::uint32_t > entities( dense.size(), resource );
+
+			for( std::uint32_t slot = 0; slot < order.size(); ++slot )
+			{
+				RelocateAt( data[chunks + ( slot >> chunkShift )] + ( slot & chunkMask ) * elementSize, GetDense( order[slot] ) );
+				entities[slot] = dense[order[slot]];
+				sparse.Set( entities[slot], slot );
+			}
+
+			for( std::size_t i = 0; i < chunks; ++i )
+			{
+				std::swap( data[i], data[chunks + i] );
+				std::vector< bool >::swap( largePageChunks[i], largePageChunks[chunks + i] );
+			}
+
+			while( data.size() > chunks )
+				FreeLastChunk();
+
+			dense.swap( entities );
+			return true;
+		}
+
+		bool Contains( const std::uint32_t index ) const
+		{
+			return GetSlot( index ) != InvalidIndex;
+		}
+
+		std::uint32_t GetSlot( const std::uint32_t index ) const
+		{
+			return sparse.Get( index );
+		}
+
+		void* Get( const std::uint32_t index )
+		{
+			const auto slot = GetSlot( index );
+			assert( slot != InvalidIndex );
+			return GetDense( slot );
 		}
 
-		void* Get( const std::size_t index ) 
+		const void* Get( const std::uint32_t index ) const
 		{
-			assert( index < count );
-			return static_cast< void* >( data[index / chunkSize] + ( index % chunkSize ) * elementSize );
+			const auto slot = GetSlot( index );
+			assert( slot != InvalidIndex );
+			return GetDense( slot );
 		}
 
-		const void* Get( const std::size_t index ) const
+		void* GetDense( const std::size_t slot )
 		{
-			assert( index < count );
-			return static_cast< const void* >( data[index / chunkSize] + ( index % chunkSize ) * elementSize );
+			assert( slot < dense.size() );
+			return static_cast< void* >( data[slot >> chunkShift] + ( slot & chunkMask ) * elementSize );
 		}
 
-		virtual void* ConstructEmpty( const size_t index, const Object& object ) = 0;
-		virtual void Destroy( const std::size_t index ) = 0;
+		const void* GetDense( const std::size_t slot ) const
+		{
+			assert( slot < dense.size() );
+			return static_cast< const void* >( data[slot >> chunkShift] + ( slot & chunkMask ) * elementSize );
+		}
+
+		void* ConstructEmpty( const std::uint32_t index, const Object& object )
+		{
+			return ConstructEmptyAt( Allocate( index ), object );
+		}
+
+		void* ConstructCopy( const std::uint32_t index, const void* source )
+		{
+			return CopyConstructAt( Allocate( index ), source );
+		}
+
+		// Type erased construction / destruction / relocation of a single component at the given address
+		// Used by the pool itself, and by archetype storage (where the allocator only acts as a type descriptor)
+		virtual void* ConstructEmptyAt( void* ptr, const Object& object ) = 0;
+		virtual void DestroyAt( void* ptr ) = 0;
+		virtual void RelocateAt( void* destination, void* source ) = 0;
+
+		// Copy construction is only supported for types that opt in (see BaseComponent::IsPrefabClonable), as most components own something tied to their object
+		virtual bool IsCopyable() const = 0;
+		virtual void* CopyConstructAt( void* destination, const void* source ) = 0;
+
+		// Destroys the component owned by index and back fills the hole with the last component in the dense array
+		// Returns the entity index of the component that was relocated (or InvalidIndex if nothing moved)
+		std::uint32_t Destroy( const std::uint32_t index )
+		{
+			const auto slot = GetSlot( index );
+			assert( slot != InvalidIndex );
+
+			DestroyAt( GetDense( slot ) );
+
+			const auto last = ( std::uint32_t )dense.size() - 1;
+			auto relocated = InvalidIndex;
+
+			if( slot != last )
+			{
+				relocated = dense[last];
+				RelocateAt( GetDense( slot ), GetDense( last ) );
+				dense[slot] = relocated;
+				sparse.Set( relocated, slot );
+			}
+
+			sparse.Reset( index );
+			dense.pop_back();
+			return relocated;
+		}
+
+	protected:
+		// Reserves a new slot at the end of the dense array for index, returns the uninitialised memory for it
+		void* Allocate( const std::uint32_t index )
+		{
+			assert( !Contains( index ) );
+			const auto slot = ( std::uint32_t )dense.size();
+			Reserve( slot + 1 );
+			dense.push_back( index );
+			sparse.Set( index, slot );
+			return GetDense( slot );
+		}
 
 	protected:
+		std::pmr::memory_resource* resource = nullptr;
 		std::vector< char* > data;
+		std::vector< bool > largePageChunks;
+		SparseIndex sparse;
+		std::pmr::vector< std::uint32_t > dense;
 		const std::size_t elementSize = 0;
+		const std::size_t alignment = 0;
 		const std::size_t chunkSize = 0;
-		std::size_t count = 0;
+		const std::size_t chunkShift = 0;
+		const std::size_t chunkMask = 0;
 		std::size_t capacity = 0;
+
+	private:
+		static std::size_t Log2( std::size_t value )
+		{
+			std::size_t shift = 0;
+			while( value >>= 1 )
+				++shift;
+			return shift;
+		}
+
+		char* AllocateChunk()
+		{
+			const auto bytes = GetChunkBytes();
+
+			if( s_largePageSize && bytes >= s_largePageSize )
+			{
+				// Large pages are always aligned to the large page size
+				if( auto* chunk = static_cast< char* >( AllocateLargePages( ( bytes + s_largePageSize - 1 ) / s_largePageSize * s_largePageSize ) ) )
+				{
+					largePageChunks.push_back( true );
+					return chunk;
+				}
+			}
+
+			largePageChunks.push_back( false );
+			return static_cast< char* >( resource->allocate( bytes, alignment ) );
+		}
+
+		void FreeLastChunk()
+		{
+			if( largePageChunks.back() )
+				FreeLargePages( data.back() );
+			else
+				resource->deallocate( data.back(), GetChunkBytes(), alignment );
+
+			data.pop_back();
+			largePageChunks.pop_back();
+			capacity -= chunkSize;
+		}
+
+		static inline std::size_t s_largePageSize = 0;
 	};
 
 	template< typename T >
 	class ComponentAllocator : public ComponentAllocatorBase
 	{
 	public:
-		ComponentAllocator( const std::size_t count, const std::size_t chunkSize = 8192 )
-			: ComponentAllocatorBase( count, sizeof( T ), chunkSize )
+		ComponentAllocator( const std::size_t chunkBytes = DefaultChunkBytes, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+			: ComponentAllocatorBase( sizeof( T ), alignof( T ), chunkBytes, resource )
 		{
 		}
 
-		T* Get( const std::size_t index )
+		T* Get( const std::uint32_t index )
 		{
 			return static_cast< T* >( ComponentAllocatorBase::Get( index ) );
 		}
 
-		const T* Get( const std::size_t index ) const
+		const T* Get( const std::uint32_t index ) const
 		{
 			return static_cast< const T* >( ComponentAllocatorBase::Get( index ) );
 		}
 
-		void* ConstructEmpty( const size_t index, const Object& object )
+		T* GetDense( const std::size_t slot )
+		{
+			return static_cast< T* >( ComponentAllocatorBase::GetDense( slot ) );
+		}
+
+		const T* GetDense( const std::size_t slot ) const
 		{
-			return ( void* )Construct( index, object );
+			return static_cast< const T* >( ComponentAllocatorBase::GetDense( slot ) );
 		}
 
 		template< typename... Args >
-		T* Construct( const std::size_t index, Args&& ... args )
+		T* Construct( const std::uint32_t index, Args&& ... args )
+		{
+			return new( Allocate( index ) ) T( std::forward<Args>( args )... );
+		}
+
+		void* ConstructEmptyAt( void* ptr, const Object& object ) final
+		{
+			return ( void* )new( ptr ) T( object );
+		}
+
+		void DestroyAt( void* ptr ) final
 		{
-			ExpandToFit( index );
-			assert( index < count );
-			new( Get( index ) ) T( std::forward<Args>( args )... );
-			return Get( index );
+			static_cast< T* >( ptr )->~T();
+		}
+
+		void RelocateAt( void* destination, void* source ) final
+		{
+			auto* from = static_cast< T* >( source );
+			new( destination ) T( std::move( *from ) );
+			from->~T();
+		}
+
+		bool IsCopyable() const final { return T::IsPrefabClonable; }
+
+		void* CopyConstructAt( void* destination, const void* source ) final
+		{
+			if constexpr( T::IsPrefabClonable )
+			{
+				return ( void* )new( destination ) T( *static_cast< const T* >( source ) );
+			}
+			else
+			{
+				assert( false );
+				return nullptr;
+			}
 		}
 
-		void Destroy( const std::size_t index )
+		// Iterates the densely packed components, components of this type must not be added or removed during iteration
+		template< typename Func >
+		void ForEach( Func f )
 		{
-			assert( index < count );
-			Get( index )->~T();
+			for( std::size_t slot = 0; slot < dense.size(); ++slot )
+				f( *GetDense( slot ) );
 		}
 	};
 }
\ No newline at end of file
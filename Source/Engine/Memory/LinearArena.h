@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace Reflex::Core
+{
+	// Bump allocator for transient allocations, use through the std::pmr containers (eg. FrameVector)
+	// Deallocation does nothing, everything is released at once by Reset, so nothing allocated from it may be kept past a Reset
+	// If the block runs out the extra allocations come from the upstream resource, and the next Reset grows the block to cover them
+	// That way steady state frames never touch the heap
+	class LinearArena : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr std::size_t DefaultBytes = 256 * 1024;
+
+		explicit LinearArena( const std::size_t bytes = DefaultBytes, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource() )
+			: m_upstream( upstream )
+		{
+			Grow( bytes );
+		}
+
+		~LinearArena()
+		{
+			ReleaseOverflow();
+			m_upstream->deallocate( m_block, m_capacity, alignof( std::max_align_t ) );
+		}
+
+		LinearArena( const LinearArena& ) = delete;
+		LinearArena& operator=( const LinearArena& ) = delete;
+
+		void Reset()
+		{
+			if( !m_overflow.empty() )
+			{
+				const auto required = m_offset + m_overflowBytes;
+				ReleaseOverflow();
+				m_upstream->deallocate( m_block, m_capacity, alignof( std::max_align_t ) );
+				Grow( required + required / 2 );
+			}
+
+			m_offset = 0;
+		}
+
+		std::size_t GetUsed() const { return m_offset + m_overflowBytes; }
+		std::size_t GetCapacity() const { return m_capacity; }
+		std::size_t GetPeak() const { return m_peak; }
+
+		// Number of allocations that didn't fit in the block and went to the upstream resource (since construction)
+		std::size_t GetOverflowCount() const { return m_overflowCount; }
+
+	protected:
+		void* do_allocate( const std::size_t bytes, const std::size_t alignment ) final
+		{
+			// The block itself is only aligned to max_align_t, so the address is aligned rather than the offset
+			void* ptr = m_block + m_offset;
+			auto space = m_capacity - m_offset;
+
+			if( std::align( alignment, bytes, ptr, space ) )
+			{
+				m_offset = m_capacity - space + bytes;
+				m_peak = std::max( m_peak, GetUsed() );
+				return ptr;
+			}
+
+			auto* overflow = m_upstream->allocate( bytes, alignment );
+			m_overflow.push_back( { overflow, bytes, alignment } );
+			m_overflowBytes += bytes;
+			m_peak = std::max( m_peak, GetUsed() );
+			++m_overflowCount;
+			return overflow;
+		}
+
+		void do_deallocate( void* ptr, const std::size_t bytes, const std::size_t alignment ) final { }
+		bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept final { return this == &other; }
+
+	private:
+		void Grow( const std::size_t bytes )
+		{
+			m_capacity = std::max( bytes, std::size_t( 1024 ) );
+			m_block = static_cast< char* >( m_upstream->allocate( m_capacity, alignof( std::max_align_t ) ) );
+		}
+
+		void ReleaseOverflow()
+		{
+			for( const auto& allocation : m_overflow )
+				m_upstream->deallocate( allocation.ptr, allocation.bytes, allocation.alignment );
+
+			m_overflow.clear();
+			m_overflowBytes = 0;
+		}
+
+		struct Allocation
+		{
+			void* ptr;
+			std::size_t bytes;
+			std::size_t alignment;
+		};
+
+		std::pmr::memory_resource* m_upstream = nullptr;
+		char* m_block = nullptr;
+		std::size_t m_capacity = 0;
+		std::size_t m_offset = 0;
+		std::size_t m_peak = 0;
+		std::vector< Allocation > m_overflow;
+		std::size_t m_overflowBytes = 0;
+		std::size_t m_overflowCount = 0;
+	};
+
+	// Vector allocating from a frame arena (World::GetFrameArena), only valid until the end of the current update / render
+	template< typename T >
+	using FrameVector = std::pmr::vector< T >;
+}
\ No newline at end of file
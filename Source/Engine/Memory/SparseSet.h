@@ -0,0 +1,117 @@
+#pragma once
+
+namespace Reflex
+{
+	// Paged map from an index (usually an object index) to a slot in a densely packed array
+	// Pages are only allocated once an index in their range is used, so memory follows the indices actually stored rather than the largest one
+	class SparseIndex
+	{
+	public:
+		static constexpr std::uint32_t InvalidIndex = std::numeric_limits< std::uint32_t >::max();
+		static constexpr std::size_t PageSize = 4096;
+
+		std::uint32_t Get( const std::uint32_t index ) const
+		{
+			const auto page = index / PageSize;
+			if( page >= pages.size() || !pages[page] )
+				return InvalidIndex;
+			return pages[page][index % PageSize];
+		}
+
+		void Set( const std::uint32_t index, const std::uint32_t slot )
+		{
+			const auto page = index / PageSize;
+
+			if( page >= pages.size() )
+				pages.resize( page + 1 );
+
+			if( !pages[page] )
+			{
+				pages[page] = std::make_unique< std::uint32_t[] >( PageSize );
+				std::fill_n( pages[page].get(), PageSize, InvalidIndex );
+			}
+
+			pages[page][index % PageSize] = slot;
+		}
+
+		void Reset( const std::uint32_t index )
+		{
+			const auto page = index / PageSize;
+			if( page < pages.size() && pages[page] )
+				pages[page][index % PageSize] = InvalidIndex;
+		}
+
+		void Clear() { pages.clear(); }
+
+		// Releases the pages which no longer map any index, returns the number of bytes released
+		std::size_t Shrink()
+		{
+			std::size_t released = 0;
+
+			for( auto& page : pages )
+			{
+				if( page && std::all_of( page.get(), page.get() + PageSize, []( const std::uint32_t slot ) { return slot == InvalidIndex; } ) )
+				{
+					page.reset();
+					released += PageSize * sizeof( std::uint32_t );
+				}
+			}
+
+			while( !pages.empty() && !pages.back() )
+				pages.pop_back();
+
+			pages.shrink_to_fit();
+			return released;
+		}
+
+	private:
+		std::vector< std::unique_ptr< std::uint32_t[] > > pages;
+	};
+
+	// Set of indices with O(1) insert / erase / contains, plus a densely packed array of the indices for iteration
+	// Erasing moves the last index into the hole, so the order is not stable and the set must not be modified while iterating it
+	class SparseSet
+	{
+	public:
+		typedef std::vector< std::uint32_t >::const_iterator const_iterator;
+
+		bool Insert( const std::uint32_t index )
+		{
+			if( Contains( index ) )
+				return false;
+
+			sparse.Set( index, ( std::uint32_t )dense.size() );
+			dense.push_back( index );
+			return true;
+		}
+
+		bool Erase( const std::uint32_t index )
+		{
+			const auto slot = sparse.Get( index );
+
+			if( slot == SparseIndex::InvalidIndex )
+				return false;
+
+			const auto last = dense.back();
+			dense[slot] = last;
+			sparse.Set( last, slot );
+			dense.pop_back();
+			sparse.Reset( index );
+			return true;
+		}
+
+		bool Contains( const std::uint32_t index ) const { return sparse.Get( index ) != SparseIndex::InvalidIndex; }
+		void Clear() { sparse.Clear(); dense.clear(); }
+		std::size_t Shrink() { dense.shrink_to_fit(); return sparse.Shrink(); }
+		bool Empty() const { return dense.empty(); }
+		std::size_t Size() const { return dense.size(); }
+
+		const std::vector< std::uint32_t >& GetDense() const { return dense; }
+		const_iterator begin() const { return dense.begin(); }
+		const_iterator end() const { return dense.end(); }
+
+	private:
+		SparseIndex sparse;
+		std::vector< std::uint32_t > dense;
+	};
+}
\ No newline at end of file
@@ -96,6 +96,31 @@ namespace Reflex
 		Object object;
 	};
 
+	// Handle which caches the resolved component pointer, useful in hot code that dereferences the same component repeatedly
+	// The pointer is only re-resolved through the world when the world's structural version changes (any component added / removed or object destroyed)
+	// Destroying the object also bumps the version, so the generation counter is re-checked whenever the cache could be stale
+	template< class T >
+	class PinnedHandle
+	{
+	public:
+		PinnedHandle() {}
+		PinnedHandle( const Object& object ) : object( object ) { }
+		PinnedHandle( const Handle< T >& handle ) : object( handle.object ) { }
+		T* Get() const;
+		T* operator->() const { return Get(); }
+		T& operator*() const { return *Get(); }
+		bool IsValid() const { return Get() != nullptr; }
+
+		explicit operator bool() const { return IsValid(); }
+		operator Handle< T >() const { return Handle< T >( object ); }
+
+		Object object;
+
+	private:
+		mutable T* cached = nullptr;
+		mutable std::uint32_t cachedVersion = 0;
+	};
+
 	// Template definitions
 	template< class T, typename... Args >
 	Handle< T > Object::AddComponent( Args&& ... args )
@@ -166,6 +191,24 @@ namespace Reflex
 		return object.IsValid() && object.HasComponent< T >();
 	}
 
+	template< class T >
+	T* PinnedHandle< T >::Get() const
+	{
+		// Null objects never resolve (and have no world to ask for the version)
+		if( cachedVersion == 0 && !object.IsValid() )
+			return nullptr;
+
+		const auto version = object.GetWorld().GetStructuralVersion();
+
+		if( cachedVersion != version )
+		{
+			cached = object.IsValid() ? object.GetWorld().template ObjectGetComponent< T >( object ) : nullptr;
+			cachedVersion = version;
+		}
+
+		return cached;
+	}
+
 	template< class T >
 	bool Handle< T >::operator==( const Handle< T >& other ) const
 	{
@@ -12,34 +12,61 @@ namespace Reflex
 		void MovementSystem::RegisterComponents()
 		{
 			RequiresComponent( Transform );
+
+			// Stays exclusive as finished rotation callbacks run game code
 		}
 
 		void MovementSystem::Update( const float deltaTime )
 		{
 			PROFILE;
-			ForEachObject< Transform >(
-				[&]( const Transform::Handle& transform )
+			std::mutex deferredMutex;
+			std::vector< Transform::TileMapMove > tileMapMoves;
+			std::vector< Transform::Handle > finishedRotations;
+			const auto bounds = GetWorld().GetBounds();
+
+			// Every object only moves itself, tile map changes and callbacks (which may add / remove components) are deferred until after
+			ParallelForEachObject< Transform >(
+				[&]( const Transform::Handle& handle )
 				{
-					if( transform->GetVelocity().x != 0.0f || transform->GetVelocity().y != 0.0f )
+					auto& transform = *handle.Get();
+
+					if( transform.GetVelocity().x != 0.0f || transform.GetVelocity().y != 0.0f )
 					{
-						const auto newPos = Reflex::WrapAround( transform->getPosition() + transform->GetVelocity() * deltaTime, GetWorld().GetBounds() );
-						transform->setPosition( newPos );
+						const auto newPos = Reflex::WrapAround( transform.getPosition() + transform.GetVelocity() * deltaTime, bounds );
+
+						if( auto move = transform.SetPositionDeferred( newPos ) )
+						{
+							std::lock_guard< std::mutex > lock( deferredMutex );
+							tileMapMoves.push_back( *move );
+						}
 
-						if( transform->FacesMovementDirection() )
-							transform->setRotation( Reflex::ToDegrees( Reflex::RotationFromVector( transform->GetVelocity() ) ) );
+						if( transform.FacesMovementDirection() )
+							transform.setRotation( Reflex::ToDegrees( Reflex::RotationFromVector( transform.GetVelocity() ) ) );
 					}
 
-					if( transform->m_rotateDurationSec > 0.0f )
+					if( transform.m_rotateDurationSec > 0.0f )
 					{
-						const float step = std::min( transform->m_rotateDurationSec, deltaTime );
-						transform->m_rotateDurationSec = std::max( 0.0f, transform->m_rotateDurationSec - deltaTime );
+						const float step = std::min( transform.m_rotateDurationSec, deltaTime );
+						transform.m_rotateDurationSec = std::max( 0.0f, transform.m_rotateDurationSec - deltaTime );
 
-						transform->rotate( transform->m_rotateDegreesPerSec * step );
+						transform.rotate( transform.m_rotateDegreesPerSec * step );
 
-						if( transform->m_rotateDurationSec == 0.0f && transform->m_finishedRotationCallback )
-							transform->m_finishedRotationCallback( transform );
+						if( transform.m_rotateDurationSec == 0.0f && transform.m_finishedRotationCallback )
+						{
+							std::lock_guard< std::mutex > lock( deferredMutex );
+							finishedRotations.push_back( handle );
+						}
 					}
 				} );
+
+			Transform::ApplyTileMapMoves( tileMapMoves );
+
+			// Called in object order, not the order the batches happened to finish in
+			std::sort( finishedRotations.begin(), finishedRotations.end(), []( const Transform::Handle& a, const Transform::Handle& b ) { return a.object.GetIndex() < b.object.GetIndex(); } );
+
+			for( const auto& transform : finishedRotations )
+				if( transform )
+					transform->m_finishedRotationCallback( transform );
 		}
 	}
 }
\ No newline at end of file
@@ -7,18 +7,37 @@ namespace Reflex::Systems
 {
 	void PhysicsSystem::RegisterComponents()
 	{
-		RequiresComponent( Reflex::Components::RigidBody );
+		RequiresComponentReadOnly( Reflex::Components::RigidBody );
+		WritesComponent( Reflex::Components::Transform );
+
+		// Only reads the bodies box2d has already stepped on the main thread
+		m_exclusive = false;
 	}
 
 	void PhysicsSystem::Update( const float deltaTime )
 	{
-		for( const auto& object : m_releventObjects )
-		{
-			if( const auto rigidBody = object.GetComponent< Reflex::Components::RigidBody >() )
+		PROFILE;
+		std::mutex tileMapMutex;
+		std::vector< Reflex::Components::Transform::TileMapMove > tileMapMoves;
+
+		ParallelForEachObject< Reflex::Components::RigidBody >(
+			[&]( const Reflex::Components::RigidBody::Handle& rigidBody )
 			{
-				object.GetTransform()->setPosition( rigidBody->GetPosition() );
-				object.GetTransform()->setRotation( rigidBody->GetRotation() );
-			}
-		}
+				const auto transform = rigidBody->GetTransform();
+
+				// Sleeping bodies don't move, so unless something else has moved the transform since the last sync it's already in place
+				if( !rigidBody->IsAwake() && !transform->ChangedSince( GetLastChangeTick() ) )
+					return;
+
+				if( auto move = transform->SetPositionDeferred( rigidBody->GetPosition() ) )
+				{
+					std::lock_guard< std::mutex > lock( tileMapMutex );
+					tileMapMoves.push_back( *move );
+				}
+
+				transform->setRotation( rigidBody->GetRotation() );
+			} );
+
+		Reflex::Components::Transform::ApplyTileMapMoves( tileMapMoves );
 	}
 }
\ No newline at end of file
@@ -6,22 +6,39 @@
 
 namespace Reflex::Systems
 {
-	bool RenderSystem::ShouldAddObject( const Object& object ) const
+	ComponentsMask RenderSystem::GetObservedComponents() const
 	{
-		for( unsigned i = 0; i < Reflex::MaxComponents; ++i )
-			if( const auto* cmp = GetWorld().ObjectGetComponent( object, i ) )
-				if( cmp->IsRenderComponent() )
-					return true;
+		return GetWorld().GetRenderComponents();
+	}
 
-		return false;
+	bool RenderSystem::ShouldAddObject( const Object& object, const ComponentsMask& components ) const
+	{
+		return components.Intersects( GetWorld().GetRenderComponents() );
 	}
 
 	void RenderSystem::AddComponent( const Object& object )
 	{
-		m_releventObjects.insert( GetInsertionIndex( object ), object );
+		const auto position = m_releventObjects.insert( GetInsertionIndex( object ), object );
+		UpdateSlots( position - m_releventObjects.begin() );
+	}
+
+	void RenderSystem::RemoveComponent( const Object& object )
+	{
+		const auto slot = m_objectSlots.Get( object.GetIndex() );
+		assert( slot != SparseIndex::InvalidIndex );
+
+		m_releventObjects.erase( m_releventObjects.begin() + slot );
+		m_objectSlots.Reset( object.GetIndex() );
+		UpdateSlots( slot );
+	}
+
+	void RenderSystem::UpdateSlots( const std::size_t from )
+	{
+		for( auto i = from; i < m_releventObjects.size(); ++i )
+			m_objectSlots.Set( m_releventObjects[i].GetIndex(), ( std::uint32_t )i );
 	}
 
-	std::vector< Reflex::Object >::const_iterator RenderSystem::GetInsertionIndex( const Object& object ) const
+	std::pmr::vector< Reflex::Object >::const_iterator RenderSystem::GetInsertionIndex( const Object& object ) const
 	{
 		return std::lower_bound( m_releventObjects.begin(), m_releventObjects.end(), object, []( const Reflex::Object& left, const Reflex::Object& right )
 		{
@@ -36,9 +53,12 @@ namespace Reflex::Systems
 
 	void RenderSystem::OnRenderIndexChanged( const Components::Transform::RenderIndexChangedEvent& e )
 	{
-		m_releventObjects.erase( Reflex::Find( m_releventObjects, e.object ) );
-		const auto newPos = GetInsertionIndex( e.object );
-		m_releventObjects.insert( newPos, e.object );
+		// The subscription outlives the object being in this system
+		if( !ContainsObject( e.object ) )
+			return;
+
+		RemoveComponent( e.object );
+		AddComponent( e.object );
 	}
 
 	void RenderSystem::Render( sf::RenderTarget& target, sf::RenderStates states ) const
@@ -48,16 +68,12 @@ namespace Reflex::Systems
 
 		for( const auto& object : m_releventObjects )
 		{
-			for( unsigned i = 0; i < Reflex::MaxComponents; ++i )
+			( object.GetComponentFlags() & GetWorld().GetRenderComponents() ).ForEachSetBit( [&]( const ComponentFamily family )
 			{
-				const auto* cmp = GetWorld().ObjectGetComponent( object, i );
-
-				if( !cmp || !cmp->IsRenderComponent() )
-					continue;
-
+				const auto* cmp = GetWorld().ObjectGetComponent( object, family );
 				copied_states.transform = object.GetTransform()->GetWorldTransform();
 				cmp->Render( target, copied_states );
-			}
+			} );
 		}
 	}
 }
\ No newline at end of file
@@ -10,9 +10,12 @@ namespace Reflex::Systems
 	public:
 		using System::System;
 
-		void RegisterComponents() final { }
-		bool ShouldAddObject( const Object& object ) const final;
+		// Drawing happens in Render, the update does nothing so it never needs to run alone
+		void RegisterComponents() final { m_exclusive = false; }
+		ComponentsMask GetObservedComponents() const final;
+		bool ShouldAddObject( const Object& object, const ComponentsMask& components ) const final;
 		void AddComponent( const Object& object ) final;
+		void RemoveComponent( const Object& object ) final;
 		void OnComponentAdded( const Reflex::Object& object ) final;
 
 		void Render( sf::RenderTarget& target, sf::RenderStates states ) const final;
@@ -22,7 +25,11 @@ namespace Reflex::Systems
 		// Transform event callback
 		void OnRenderIndexChanged( const Components::Transform::RenderIndexChangedEvent& e );
 
-		std::vector< Reflex::Object >::const_iterator GetInsertionIndex( const Object& object ) const;
+		std::pmr::vector< Reflex::Object >::const_iterator GetInsertionIndex( const Object& object ) const;
+
+	protected:
+		// Objects are kept sorted by render index, so inserting / erasing shifts the slots of every object after the position
+		void UpdateSlots( const std::size_t from );
 
 	protected:
 		std::vector< Reflex::ComponentFamily > m_objectRenderComponents;
@@ -12,26 +12,43 @@ namespace Reflex::Systems
 	void SteeringSystem::RegisterComponents()
 	{
 		RequiresComponent( Reflex::Components::Steering );
+		WritesComponent( Reflex::Components::Transform );
+		m_exclusive = false;
 	}
 
 	void SteeringSystem::Update( const float deltaTime )
 	{
 		PROFILE;
-		ForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& boid )
+
+		// Steering reads the neighbours' transforms, so every boid's force is worked out before any velocity changes
+		ParallelForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& boid )
+		{
+			UpdateSteering( boid );
+		} );
+
+		ParallelForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& boid )
 		{
 			Integrate( boid, deltaTime );
 		} );
 	}
 
+	void SteeringSystem::UpdateSteering( const Steering::Handle& boid ) const
+	{
+		const auto transform = boid->GetObject().GetTransform();
+
+		if( boid->m_maxForce <= 0.0f || transform->GetMaxVelocity() <= 0.0f )
+			return;
+
+		boid->m_steering = Steering( boid );
+	}
+
 	void SteeringSystem::Integrate( const Steering::Handle& boid, const float deltaTime ) const
 	{
-		PROFILE;
 		auto transform = boid->GetObject().GetTransform();
 
 		if( boid->m_maxForce <= 0.0f || transform->GetMaxVelocity() <= 0.0f )
 			return;
 
-		boid->m_steering = Steering( boid );
 		const auto acceleration = boid->m_steering / boid->m_mass;
 		transform->SetVelocity( transform->GetVelocity() + acceleration * deltaTime );
 	}
@@ -91,21 +108,36 @@ namespace Reflex::Systems
 
 	sf::Vector2f SteeringSystem::Wander( const Steering::Handle& boid ) const
 	{
-		PROFILE;
 		assert( boid->m_wanderCircleRadius > 0.0f );
 		if( boid->m_wanderCircleRadius <= 0.0f )
 			return {};
 
-		auto transform = boid->GetObject().GetTransform();
+		const auto transform = boid->GetObject().GetTransform();
 
-		if( transform->GetVelocity().x == 0.0f && transform->GetVelocity().y == 0.0f )
-			transform->SetVelocity( Reflex::RandomUnitVector() );
+		// Stationary boids wander off in a random direction (the velocity itself is only changed by Integrate, as other boids may be reading it)
+		auto velocity = transform->GetVelocity();
+		if( velocity.x == 0.0f && velocity.y == 0.0f )
+			velocity = Reflex::RotateVector( sf::Vector2f( 1.0f, 0.0f ), RandomFloat( boid, 0.0f, Reflex::PI2 ) );
 
-		boid->m_wanderDirection.x += Reflex::RandomFloat( -boid->m_wanderJitter / 2.0f, boid->m_wanderJitter / 2.0f ) * GetWorld().GetDeltaTime();
-		boid->m_wanderDirection.y += Reflex::RandomFloat( -boid->m_wanderJitter / 2.0f, boid->m_wanderJitter / 2.0f ) * GetWorld().GetDeltaTime();
+		boid->m_wanderDirection.x += RandomFloat( boid, -boid->m_wanderJitter / 2.0f, boid->m_wanderJitter / 2.0f ) * GetWorld().GetDeltaTime();
+		boid->m_wanderDirection.y += RandomFloat( boid, -boid->m_wanderJitter / 2.0f, boid->m_wanderJitter / 2.0f ) * GetWorld().GetDeltaTime();
 		Reflex::ScaleTo( boid->m_wanderDirection, boid->m_wanderCircleRadius );
-		const auto targetForce = Reflex::ScaleTo( Reflex::ScaleTo( transform->GetVelocity(), boid->m_wanderCircleDistance ) + boid->m_wanderDirection, transform->GetMaxVelocity() );
-		return ( targetForce - transform->GetVelocity() ) * boid->m_wanderForce * boid->m_forceMultiplier;
+		const auto targetForce = Reflex::ScaleTo( Reflex::ScaleTo( velocity, boid->m_wanderCircleDistance ) + boid->m_wanderDirection, transform->GetMaxVelocity() );
+		return ( targetForce - velocity ) * boid->m_wanderForce * boid->m_forceMultiplier;
+	}
+
+	float SteeringSystem::RandomFloat( const Steering::Handle& boid, const float min, const float max ) const
+	{
+		// Xorshift32, only ever touched by the job updating this boid
+		auto& state = boid->m_randomState;
+
+		if( state == 0 )
+			state = ( boid->GetObject().GetIndex() + 1 ) * 2654435761U ^ 0x9E3779B9U;
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return min + ( state >> 8 ) / float( 1 << 24 ) * ( max - min );
 	}
 
 	sf::Vector2f SteeringSystem::Pursue( const Steering::Handle& boid, const Object& target, const bool useArrival ) const
@@ -125,23 +157,26 @@ namespace Reflex::Systems
 		return -Pursue( boid, target, false );
 	}
 
-	sf::Vector2f SteeringSystem::Flocking( const Steering::Handle& boid ) const
+	sf::Vector2f SteeringSystem::Flocking( const Steering::Handle& handle ) const
 	{
+		// Pinned so the repeated dereferences below (once per neighbour) only resolve through the world once
+		const Reflex::PinnedHandle< Reflex::Components::Steering > boid( handle );
+		const Reflex::PinnedHandle< Reflex::Components::Transform > transform( boid->GetTransform() );
+
 		sf::Vector2f alignment, cohesion, separation;
-		const auto pos = boid->GetTransform()->getPosition();
+		const auto pos = transform->getPosition();
 		unsigned counter = 0;
 
 #ifndef DISABLE_TILEMAP
 		GetWorld().GetTileMap().ForEachInRange( pos, boid->m_neighbourRange, [&]( const Reflex::Object& nearby )
 		{
-			if( boid == nearby || !nearby.HasComponent< Reflex::Components::Steering >() )
+			if( handle == nearby || !nearby.HasComponent< Reflex::Components::Steering >() )
 				return;
 #else
-		ForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& steering )
+		// Every boid is a neighbour, not just the ones in the current time slice
+		std::for_each( GetObjects().begin(), GetObjects().end(), [&]( const Reflex::Object& nearby )
 		{
-			const auto nearby = steering->GetObject();
-
-			if( boid == nearby )
+			if( handle == nearby )
 				return;
 #endif
 			const auto nearbyTransform = nearby.GetTransform();
@@ -159,10 +194,10 @@ namespace Reflex::Systems
 
 		if( counter )
 		{
-			const auto direction = Reflex::Normalise( boid->GetTransform()->GetVelocity() );
+			const auto direction = Reflex::Normalise( transform->GetVelocity() );
 			
 			cohesion /= ( float )counter;
-			cohesion = Reflex::Normalise( Reflex::Normalise( cohesion - boid->GetTransform()->getPosition() ) - direction );
+			cohesion = Reflex::Normalise( Reflex::Normalise( cohesion - transform->getPosition() ) - direction );
 
 			alignment /= ( float )counter;
 			alignment = Reflex::Normalise( alignment - direction );
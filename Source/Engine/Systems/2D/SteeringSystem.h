@@ -16,6 +16,7 @@ namespace Reflex::Systems
 		void Update( const float deltaTime ) final;
 
 	protected:
+		void UpdateSteering( const Steering::Handle& boid ) const;
 		void Integrate( const Steering::Handle& boid, const float deltaTime ) const;
 		sf::Vector2f Steering( const Steering::Handle& boid ) const;
 
@@ -23,6 +24,7 @@ namespace Reflex::Systems
 		sf::Vector2f Flee( const Steering::Handle& boid, const sf::Vector2f& target ) const;
 		sf::Vector2f Arrival( const Steering::Handle& boid, const sf::Vector2f& target ) const;
 		sf::Vector2f Wander( const Steering::Handle& boid ) const;
+		float RandomFloat( const Steering::Handle& boid, const float min, const float max ) const;
 		sf::Vector2f Pursue( const Steering::Handle& boid, const Object& target, const bool useArrival = true ) const;
 		sf::Vector2f Evade( const Steering::Handle& boid, const Object& target ) const;
 		sf::Vector2f Flocking( const Steering::Handle& boid ) const;
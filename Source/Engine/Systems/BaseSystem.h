@@ -1,6 +1,6 @@
 #pragma once
 
-namespace Reflex::Core { class World; }
+namespace Reflex::Core { class World; class CommandBuffer; }
 namespace Reflex { class Object; }
 
 namespace Reflex::Systems
@@ -17,6 +17,32 @@ namespace Reflex::Systems
 		Reflex::Core::World& GetWorld() { return m_world; }
 		const Reflex::Core::World& GetWorld() const { return m_world; }
 		ComponentsMask GetRequiredComponents() const { return m_requiredComponents; }
+		ComponentsMask GetReadComponents() const { return m_readComponents; }
+		ComponentsMask GetWriteComponents() const { return m_writeComponents; }
+		bool IsExclusive() const { return m_exclusive; }
+
+		// Structural changes made by the system should be recorded here rather than in the world's buffer
+		// While the system updates in a parallel stage this is its own buffer, which the world appends in schedule order once the stage is done
+		Reflex::Core::CommandBuffer& GetCommandBuffer() { return *m_commandBuffer; }
+
+		// Systems update every world update by default, a rate limits it to that many updates a second
+		// The delta time passed to Update is then the time since the system last updated
+		void SetUpdateRate( const float updatesPerSecond ) { m_updateInterval = updatesPerSecond > 0.0f ? 1.0f / updatesPerSecond : 0.0f; }
+		float GetUpdateInterval() const { return m_updateInterval; }
+
+		// Splits the system's objects into slices, each update only processes the next slice (ForEachObject / ParallelForEachObject only visit it)
+		// Every object is updated once every N updates, and the delta time passed to Update is the time since the current slice last updated
+		void SetTimeSlices( const unsigned slices ) { m_sliceElapsed.assign( std::max( slices, 1U ), 0.0f ); m_sliceChangeTicks.assign( std::max( slices, 1U ), 0U ); m_currentSlice = 0; }
+		unsigned GetTimeSlices() const { return ( unsigned )m_sliceElapsed.size(); }
+
+		// Whether the two systems can't update at the same time (one writes a component the other accesses, or either is exclusive)
+		bool ConflictsWith( const BaseSystem& other ) const
+		{
+			if( m_exclusive || other.m_exclusive )
+				return true;
+
+			return m_writeComponents.Intersects( other.m_readComponents | other.m_writeComponents ) || other.m_writeComponents.Intersects( m_readComponents );
+		}
 
 	protected:
 		virtual void RegisterComponents() = 0;
@@ -28,18 +54,78 @@ namespace Reflex::Systems
 		virtual void OnSystemStartup() { }
 		virtual void OnSystemShutdown() { }
 
-		virtual bool ShouldAddObject( const Reflex::Object& object ) const = 0;
+		// Families whose addition / removal can change whether an object matches the system, the world only asks the systems observing the family that changed
+		// The world caches these, so a system overriding it must call World::InvalidateObservers when the result changes
+		// A system without required components matches every object, so it observes every family
+		virtual ComponentsMask GetObservedComponents() const { return m_requiredComponents.any() ? m_requiredComponents : ComponentsMask().set(); }
+
+		// Components is the object's components mask (after the change being processed), the result must only depend on it
+		virtual bool ShouldAddObject( const Reflex::Object& object, const ComponentsMask& components ) const = 0;
 		virtual void AddComponent( const Reflex::Object& object ) = 0;
+		virtual void RemoveComponent( const Reflex::Object& object ) = 0;
 		virtual void OnComponentAdded( const Reflex::Object& object ) { }
 		virtual void OnComponentRemoved( const Reflex::Object& object ) { }
 
+		unsigned GetCurrentSlice() const { return m_currentSlice; }
+
+		// Change tick the current slice last updated in (0 if it never has), components changed since it are newer than the system has seen
+		std::uint32_t GetLastChangeTick() const { return m_lastChangeTick; }
+
 	private:
 		void draw( sf::RenderTarget& target, sf::RenderStates states ) const final { Render( target, states ); }
 
+		// Called by the world every update, applies the update rate and time slicing before calling Update
+		void Tick( const float deltaTime, const std::uint32_t changeTick )
+		{
+			m_timeSinceUpdate += deltaTime;
+
+			for( auto& elapsed : m_sliceElapsed )
+				elapsed += deltaTime;
+
+			if( m_timeSinceUpdate < m_updateInterval )
+				return;
+
+			// The time past the interval counts towards the next update, so the rate holds on average whatever the frame time
+			// Clamped to one interval so a long frame doesn't cause a run of back to back updates
+			m_timeSinceUpdate = std::min( m_timeSinceUpdate - m_updateInterval, m_updateInterval );
+
+			const auto sliceDeltaTime = m_sliceElapsed[m_currentSlice];
+			m_sliceElapsed[m_currentSlice] = 0.0f;
+			m_lastChangeTick = m_sliceChangeTicks[m_currentSlice];
+			m_sliceChangeTicks[m_currentSlice] = changeTick;
+			Update( sliceDeltaTime );
+
+			m_currentSlice = ( m_currentSlice + 1 ) % ( unsigned )m_sliceElapsed.size();
+		}
+
 	protected:
 		ComponentsMask m_requiredComponents;
 
+		// Component access declared in RegisterComponents, used by the world to schedule systems which don't conflict in parallel
+		ComponentsMask m_readComponents;
+		ComponentsMask m_writeComponents;
+
+		// Exclusive systems update on the main thread with no other system running
+		// A system may only clear this if its update touches nothing but its declared components (no window / input, box2d writes, game callbacks etc.)
+		bool m_exclusive = true;
+
 	private:
 		Reflex::Core::World& m_world;
+
+		// Set by the world, points at the world's buffer except while the system updates in a parallel stage
+		Reflex::Core::CommandBuffer* m_commandBuffer = nullptr;
+
+		float m_updateInterval = 0.0f;
+
+		// Time towards the next update (not the time since the last one, see Tick)
+		float m_timeSinceUpdate = 0.0f;
+
+		// Time since each slice was last updated
+		std::vector< float > m_sliceElapsed = std::vector< float >( 1, 0.0f );
+		unsigned m_currentSlice = 0;
+
+		// Change tick each slice last updated in
+		std::vector< std::uint32_t > m_sliceChangeTicks = std::vector< std::uint32_t >( 1, 0U );
+		std::uint32_t m_lastChangeTick = 0;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Components/Component.h"
 #include "Objects/Object.h"
 #include "Systems/BaseSystem.h"
+#include "Memory/SparseSet.h"
+#include "Core/JobSystem.h"
+#include "Core/CommandBuffer.h"
 
 namespace Reflex::Core { class World; }
 
@@ -10,9 +13,25 @@ namespace Reflex::Systems
 {
 	using namespace Reflex::Core;
 
+// Required components are assumed to be written, unless declared with RequiresComponentReadOnly
 #define RequiresComponent( T ) \
 	GetWorld().RegisterComponent< T >(); \
-	m_requiredComponents.set( T::GetFamily() );
+	m_requiredComponents.set( T::GetFamily() ); \
+	m_writeComponents.set( T::GetFamily() );
+
+#define RequiresComponentReadOnly( T ) \
+	GetWorld().RegisterComponent< T >(); \
+	m_requiredComponents.set( T::GetFamily() ); \
+	m_readComponents.set( T::GetFamily() );
+
+// Access to components the system doesn't require (eg. the transform of a required component's object)
+#define ReadsComponent( T ) \
+	GetWorld().RegisterComponent< T >(); \
+	m_readComponents.set( T::GetFamily() );
+
+#define WritesComponent( T ) \
+	GetWorld().RegisterComponent< T >(); \
+	m_writeComponents.set( T::GetFamily() );
 
 	class System : public BaseSystem
 	{
@@ -20,30 +39,162 @@ namespace Reflex::Systems
 		friend class Reflex::Core::World;
 
 		// Constructors / Destructors
-		System( Reflex::Core::World& world ) : BaseSystem( world ) { }
+		System( Reflex::Core::World& world ) : BaseSystem( world ), m_releventObjects( world.GetMemoryResource() ) { }
 		virtual ~System() { }
 
-		const std::vector< Reflex::Object >& GetObjects() const { return m_releventObjects; }
+		const std::pmr::vector< Reflex::Object >& GetObjects() const { return m_releventObjects; }
+		bool ContainsObject( const BaseObject& object ) const { return m_objectSlots.Get( object.GetIndex() ) != SparseIndex::InvalidIndex; }
 
+		// Visits the current time slice (every object unless the system is time sliced)
 		template< typename... Args, typename Func >
 		void ForEachObject( Func f ) const
 		{
-			for( auto& object : m_releventObjects )
-				f( ( object.template GetComponent< Args >() )... );
+			const auto [begin, end] = GetSliceRange();
+
+			for( auto i = begin; i < end; ++i )
+				f( ( m_releventObjects[i].template GetComponent< Args >() )... );
+		}
+
+		// Same as ForEachObject, but only visits objects whose T component changed since the system (or the current slice) last updated
+		// Changes the system made itself during that update don't count, nor does an object joining the system without its T component changing
+		template< typename T, typename... Args, typename Func >
+		void ForEachChangedObject( Func f ) const
+		{
+			const auto since = GetLastChangeTick();
+
+			if( !GetWorld().ComponentChangedSince( T::GetFamily(), since ) )
+				return;
+
+			const auto [begin, end] = GetSliceRange();
+
+			for( auto i = begin; i < end; ++i )
+				if( m_releventObjects[i].template GetComponent< T >()->ChangedSince( since ) )
+					f( ( m_releventObjects[i].template GetComponent< Args >() )... );
+		}
+
+		// Objects in the current time slice, as objects are removed by swapping in the last object an object can occasionally be skipped or visited twice in a round of slices
+		std::pair< std::size_t, std::size_t > GetSliceRange() const
+		{
+			const auto count = m_releventObjects.size();
+			const auto slices = GetTimeSlices();
+			return { count * GetCurrentSlice() / slices, count * ( GetCurrentSlice() + 1 ) / slices };
+		}
+
+		// Roughly an L1 data cache, the objects are split into batches whose handles and components fit in this
+		static constexpr std::size_t ParallelBatchBytes = 32 * 1024;
+
+		// Same as ForEachObject (so also only visits the current time slice), but the batches are spread across the job system (returning once they have all finished)
+		// f is called from multiple threads at once, so it may only write to the components of the object it was given
+		// and must not add / remove components or objects (use ParallelForEachObjectWithCommands to record those)
+		template< typename... Args, typename Func >
+		void ParallelForEachObject( Func f ) const
+		{
+			ParallelForEachBatch< Args... >( [this, &f]( const std::size_t begin, const std::size_t end, const std::size_t )
+			{
+				for( auto i = begin; i < end; ++i )
+					f( ( m_releventObjects[i].template GetComponent< Args >() )... );
+			} );
+		}
+
+		// Same as ParallelForEachObject, but f is also given a command buffer to record structural changes into, f( commands, components... )
+		// Each batch records into its own buffer, these are appended to the system's buffer in batch order so the result doesn't depend on the threads
+		template< typename... Args, typename Func >
+		void ParallelForEachObjectWithCommands( Func f )
+		{
+			std::vector< Reflex::Core::CommandBuffer > batchCommands( GetBatchCount< Args... >() );
+
+			ParallelForEachBatch< Args... >( [this, &f, &batchCommands]( const std::size_t begin, const std::size_t end, const std::size_t batch )
+			{
+				for( auto i = begin; i < end; ++i )
+					f( batchCommands[batch], ( m_releventObjects[i].template GetComponent< Args >() )... );
+			} );
+
+			for( auto& commands : batchCommands )
+				GetCommandBuffer().Append( commands );
+		}
+
+		// Cached view of every object with the component types, ForEach passes raw references rather than handles
+		template< typename... Args >
+		ComponentView< Args... > View() { return GetWorld().template View< Args... >(); }
+
+	private:
+		template< typename... Args >
+		static constexpr std::size_t GetBatchSize()
+		{
+			constexpr auto objectBytes = sizeof( Reflex::Object ) + ( sizeof( Args ) + ... + 0 );
+			return std::max( ParallelBatchBytes / objectBytes, std::size_t( 1 ) );
+		}
+
+		template< typename... Args >
+		std::size_t GetBatchCount() const
+		{
+			const auto [first, last] = GetSliceRange();
+			return ( last - first + GetBatchSize< Args... >() - 1 ) / GetBatchSize< Args... >();
+		}
+
+		// Calls processBatch( begin, end, batch ) for each batch of the current time slice, spread across the job system
+		template< typename... Args, typename Func >
+		void ParallelForEachBatch( Func processBatch ) const
+		{
+			const auto batchSize = GetBatchSize< Args... >();
+			const auto [first, last] = GetSliceRange();
+
+			auto& jobSystem = JobSystem::GetJobSystem();
+			JobCounter counter;
+
+			// The calling thread takes the first batch
+			for( auto begin = first + batchSize; begin < last; begin += batchSize )
+				jobSystem.Run( [&processBatch, begin, end = std::min( begin + batchSize, last ), batch = ( begin - first ) / batchSize]() { processBatch( begin, end, batch ); }, counter );
+
+			if( first < last )
+			{
+				try
+				{
+					processBatch( first, std::min( first + batchSize, last ), 0 );
+				}
+				catch( ... )
+				{
+					// The queued batches reference this stack frame, so they must finish before it unwinds
+					jobSystem.Wait( counter );
+					throw;
+				}
+			}
+
+			jobSystem.Wait( counter );
 		}
 
 	protected:
-		virtual bool ShouldAddObject( const Object& object ) const override 
+		virtual bool ShouldAddObject( const Object& object, const ComponentsMask& components ) const override 
 		{ 
-			return ( object.GetComponentFlags() & GetRequiredComponents() ) == GetRequiredComponents(); 
+			return components.Contains( m_requiredComponents ); 
 		}
 
 		virtual void AddComponent( const Object& object ) override
 		{
+			m_objectSlots.Set( object.GetIndex(), ( std::uint32_t )m_releventObjects.size() );
 			m_releventObjects.push_back( object );
 		}
 
+		// Moves the last object into the removed object's slot, so the order of m_releventObjects is not stable
+		virtual void RemoveComponent( const Object& object ) override
+		{
+			const auto slot = m_objectSlots.Get( object.GetIndex() );
+			assert( slot != SparseIndex::InvalidIndex );
+
+			if( slot != m_releventObjects.size() - 1 )
+			{
+				m_releventObjects[slot] = m_releventObjects.back();
+				m_objectSlots.Set( m_releventObjects[slot].GetIndex(), slot );
+			}
+
+			m_releventObjects.pop_back();
+			m_objectSlots.Reset( object.GetIndex() );
+		}
+
 	protected:
-		std::vector< Reflex::Object > m_releventObjects;
+		std::pmr::vector< Reflex::Object > m_releventObjects;
+
+		// Object index -> position in m_releventObjects, gives O(1) membership tests / removal
+		SparseIndex m_objectSlots;
 	};
 }
\ No newline at end of file
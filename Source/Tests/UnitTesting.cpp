@@ -3,6 +3,15 @@
 #include "ReflexInclude.h"
 #include "UnitTesting.h"
 
+#include <filesystem>
+
+enum class Reflex::ResourceID : unsigned short
+{
+	TestTexture,
+	TestTextureDuplicate,
+	TestTextureMissing,
+};
+
 using namespace Reflex;
 
 class TestState;
@@ -49,6 +58,47 @@ public:
 		RegisterTest( std::bind( &TestState::TestEventScopeSafety, this ), true, "Test automatic unsubscribing" );
 		RegisterTest( std::bind( &TestState::TestEventsMulti, this ), true, "Test multiple subscribing (different objects)" );
 		RegisterTest( std::bind( &TestState::TestEventsRenderSystem, this ), true, "Test the first real usage of the event system (Render System updating object render index when it changes)" );
+
+		RegisterSection( "---- Reflex Component Storage -------" );
+		RegisterTest( std::bind( &TestState::TestComponentRemoveBackFill, this ), true, "Test removing a component keeps the remaining components of that type intact" );
+		RegisterTest( std::bind( &TestState::TestComponentAllocatorAlignment, this ), true, "Test component pool chunks hold a power of two number of elements and over aligned components are aligned" );
+		RegisterTest( std::bind( &TestState::TestComponentReAdd, this ), true, "Test removing and re-adding a component on the same object" );
+		RegisterTest( std::bind( &TestState::TestArchetypeStorage, this ), true, "Test objects moving between archetypes keep their components and only matching objects are iterated" );
+		RegisterTest( std::bind( &TestState::TestViewUpdates, this ), true, "Test cached views are updated when components are added / removed" );
+		RegisterTest( std::bind( &TestState::TestPinnedHandle, this ), true, "Test pinned handles re-resolve after the component is relocated or destroyed" );
+		RegisterTest( std::bind( &TestState::TestCreateObjects, this ), true, "Test batch created objects are fully constructed and registered with systems" );
+		RegisterTest( std::bind( &TestState::TestSystemMembership, this ), true, "Test systems track which objects they contain as components are added / removed" );
+		RegisterTest( std::bind( &TestState::TestObjectIndexReuse, this ), true, "Test destroyed object indices are reused with a new generation" );
+		RegisterTest( std::bind( &TestState::TestCompact, this ), true, "Test compacting releases empty component memory and keeps live components intact" );
+		RegisterTest( std::bind( &TestState::TestCommandBuffer, this ), true, "Test recorded structural changes are only applied when the command buffer is flushed" );
+		RegisterTest( std::bind( &TestState::TestCommandBufferNestedFlush, this ), true, "Test flushing the command buffer from a command's callback applies every command once" );
+		RegisterTest( std::bind( &TestState::TestLinearArena, this ), true, "Test the frame arena reuses its block after a reset and grows to cover overflow" );
+		RegisterTest( std::bind( &TestState::TestWorldMemoryResource, this ), true, "Test a world allocates its containers and component memory from the memory resource it was given" );
+		RegisterTest( std::bind( &TestState::TestEngineMemoryResource, this ), true, "Test an engine created from EngineParams gives its world the memory resource in the params" );
+		RegisterTest( std::bind( &TestState::TestSystemSchedule, this ), true, "Test the system schedule never runs conflicting systems together and keeps them in the order they were added" );
+		RegisterTest( std::bind( &TestState::TestJobSystem, this ), true, "Test every job (including jobs started from other jobs) has run once waiting on their counter returns" );
+		RegisterTest( std::bind( &TestState::TestJobSystemExceptions, this ), true, "Test an exception thrown by a job is rethrown by Wait once every job has finished" );
+		RegisterTest( std::bind( &TestState::TestParallelStageCommands, this ), true, "Test commands recorded from parallel jobs by systems sharing a stage are all applied, in object order" );
+		RegisterTest( std::bind( &TestState::TestComponentObservers, this ), true, "Test component changes are only dispatched to the systems observing the changed family" );
+		RegisterTest( std::bind( &TestState::TestObserveAllComponents, this ), true, "Test a system without required components is given every object" );
+		RegisterTest( std::bind( &TestState::TestSystemUpdateRate, this ), true, "Test a rate limited, time sliced system keeps its rate and each slice is given the time since it last updated" );
+		RegisterTest( std::bind( &TestState::TestChangeTracking, this ), true, "Test moving a parent invalidates its children's cached world transforms and stamps the change tick" );
+		RegisterTest( std::bind( &TestState::TestWorldTransformRelocation, this ), true, "Test a child's cached world transform is invalidated when its parent moves after being relocated in its pool" );
+		RegisterTest( std::bind( &TestState::TestPrefabInstancing, this ), true, "Test object files are compiled once and every instance gets the prefab's components and transform values" );
+		RegisterTest( std::bind( &TestState::TestWorldSnapshot, this ), true, "Test a binary world snapshot restores objects, handles, transforms and the scene graph" );
+		RegisterTest( std::bind( &TestState::TestWorldSnapshotInvalid, this ), true, "Test loading an invalid world snapshot throws, leaving the world untouched or empty if only the component data is bad" );
+		RegisterTest( std::bind( &TestState::TestComponentReflection, this ), true, "Test reflected component fields can be found, set from strings and serialised back" );
+		RegisterTest( std::bind( &TestState::TestStringConversion, this ), true, "Test numbers, vectors and colours round trip through ToString / FromString" );
+		RegisterTest( std::bind( &TestState::TestAsyncResourceLoading, this ), true, "Test async resource loads share duplicate files, use the placeholder until Update finishes them and report failures" );
+		RegisterTest( std::bind( &TestState::TestRegionStreaming, this ), true, "Test a region's objects are written out and destroyed when unloaded, then recreated when loaded again" );
+		RegisterTest( std::bind( &TestState::TestRegionStreamingDisable, this ), true, "Test disabling streaming unloads the loaded regions, so enabling it again doesn't duplicate their objects" );
+		RegisterTest( std::bind( &TestState::TestRegionStreamingInvalidFile, this ), true, "Test a truncated region file is reported and loads as an empty region instead of throwing" );
+		RegisterTest( std::bind( &TestState::TestReadObjectsInvalid, this ), true, "Test reading invalid object data throws and leaves no objects behind (before or after the components are constructed)" );
+
+		RegisterSection( "---- Reflex Benchmarks -------" );
+		RegisterTest( std::bind( &TestState::BenchmarkMovementIteration, this ), true, "Benchmark per object overhead of handles vs a cached view (MovementSystem style update)" );
+		RegisterTest( std::bind( &TestState::BenchmarkSteeringIteration, this ), true, "Benchmark per object overhead of handles vs a cached view (SteeringSystem style update)" );
+		RegisterTest( std::bind( &TestState::BenchmarkWorldCreation, this ), true, "Benchmark creating a world (breakdown of each startup step)" );
 	}
 
 protected:
@@ -156,4 +206,1171 @@ protected:
 
 		return startOrdering && newOrdering;
 	}
-};
+
+	struct alignas( 64 ) TestAlignedComponent
+	{
+		TestAlignedComponent( const Reflex::Object& object ) { }
+		static constexpr bool IsPrefabClonable = false;
+		float value = 0.0f;
+	};
+
+	bool TestComponentAllocatorAlignment()
+	{
+		// 1000 bytes fits 15 elements, which rounds down to 8 per chunk
+		Reflex::Core::ComponentAllocator< TestAlignedComponent > pool( 1000 );
+		bool result = pool.GetChunkSize() == 8 && ( pool.GetChunkSize() & ( pool.GetChunkSize() - 1 ) ) == 0;
+
+		for( std::uint32_t index = 0; index < 20; ++index )
+			pool.ConstructEmpty( index, Reflex::Object() );
+
+		result = result && pool.GetChunkCount() == 3;
+
+		for( std::size_t slot = 0; slot < pool.GetCount(); ++slot )
+			result = result && reinterpret_cast< std::uintptr_t >( pool.GetDense( slot ) ) % alignof( TestAlignedComponent ) == 0;
+
+		return result;
+	}
+
+	bool TestComponentRemoveBackFill()
+	{
+		auto object = GetWorld().CreateObject( sf::Vector2f( 1.0f, 1.0f ) );
+		auto object2 = GetWorld().CreateObject( sf::Vector2f( 2.0f, 2.0f ) );
+		auto object3 = GetWorld().CreateObject( sf::Vector2f( 3.0f, 3.0f ) );
+		object3.GetTransform()->SetVelocity( sf::Vector2f( 5.0f, 0.0f ) );
+
+		// Removing the first moves the last transform into its slot
+		object.Destroy();
+
+		const auto result = !object.IsValid() &&
+			object2.GetTransform()->getPosition() == sf::Vector2f( 2.0f, 2.0f ) &&
+			object3.GetTransform()->getPosition() == sf::Vector2f( 3.0f, 3.0f ) &&
+			object3.GetTransform()->GetVelocity() == sf::Vector2f( 5.0f, 0.0f );
+
+		object2.Destroy();
+		object3.Destroy();
+		return result;
+	}
+
+	bool TestComponentReAdd()
+	{
+		auto object = GetWorld().CreateObject();
+		object.AddComponent< Reflex::Components::CircleShape >( 5.0f );
+		object.RemoveComponent< Reflex::Components::CircleShape >();
+		const auto removed = !object.HasComponent< Reflex::Components::CircleShape >();
+		object.AddComponent< Reflex::Components::CircleShape >( 10.0f );
+
+		const auto result = removed && object.GetComponent< Reflex::Components::CircleShape >()->getRadius() == 10.0f;
+		object.Destroy();
+		return result;
+	}
+
+	bool TestArchetypeStorage()
+	{
+		const auto context = Reflex::Core::Context( GetWorld().GetWindow(), GetWorld().GetTextureManager(), GetWorld().GetFontManager() );
+		Reflex::Core::World world( context, GetWorld().GetBounds(), sf::Vector2f(), Reflex::Core::World::StorageMode::Archetype );
+
+		auto object = world.CreateObject( sf::Vector2f( 1.0f, 1.0f ) );
+		auto object2 = world.CreateObject( sf::Vector2f( 2.0f, 2.0f ) );
+		object.AddComponent< Reflex::Components::Steering >();
+		object2.AddComponent< Reflex::Components::Steering >();
+
+		// Moves object back to the transform only archetype, object2 gets back filled into its row
+		object.RemoveComponent< Reflex::Components::Steering >();
+
+		unsigned matching = 0;
+		world.ForEachMatching< Reflex::Components::Transform, Reflex::Components::Steering >( [&]( Reflex::Components::Transform& transform, Reflex::Components::Steering& steering )
+		{
+			matching += transform.getPosition() == sf::Vector2f( 2.0f, 2.0f ) ? 1 : 100;
+		} );
+
+		return matching == 1 &&
+			!object.HasComponent< Reflex::Components::Steering >() &&
+			object.GetTransform()->getPosition() == sf::Vector2f( 1.0f, 1.0f ) &&
+			object2.GetTransform()->getPosition() == sf::Vector2f( 2.0f, 2.0f );
+	}
+
+	bool TestViewUpdates()
+	{
+		auto object = GetWorld().CreateObject();
+		const auto view = GetWorld().View< Reflex::Components::Transform, Reflex::Components::Steering >();
+		const auto before = view.Size();
+
+		object.AddComponent< Reflex::Components::Steering >();
+		const auto added = view.Size() == before + 1 && view.GetObjects().Contains( object.GetIndex() );
+
+		object.RemoveComponent< Reflex::Components::Steering >();
+		const auto removed = view.Size() == before && !view.GetObjects().Contains( object.GetIndex() );
+
+		object.Destroy();
+		return added && removed;
+	}
+
+	bool TestPinnedHandle()
+	{
+		auto object = GetWorld().CreateObject( sf::Vector2f( 1.0f, 1.0f ) );
+		auto object2 = GetWorld().CreateObject( sf::Vector2f( 2.0f, 2.0f ) );
+
+		const Reflex::PinnedHandle< Reflex::Components::Transform > pinned( object2 );
+		const auto resolved = pinned->getPosition() == sf::Vector2f( 2.0f, 2.0f );
+
+		// Destroying the first object moves object2's transform into the freed slot
+		object.Destroy();
+		const auto relocated = pinned->getPosition() == sf::Vector2f( 2.0f, 2.0f );
+
+		object2.Destroy();
+		return resolved && relocated && !pinned.IsValid();
+	}
+
+	bool TestCreateObjects()
+	{
+		std::vector< Reflex::Object > objects;
+		GetWorld().CreateObjects( { sf::Vector2f( 1.0f, 1.0f ), sf::Vector2f( 2.0f, 2.0f ), sf::Vector2f( 3.0f, 3.0f ) }, objects );
+
+		const auto* movement = GetWorld().GetSystem< Reflex::Systems::MovementSystem >();
+		bool result = objects.size() == 3;
+
+		for( unsigned i = 0; i < objects.size(); ++i )
+		{
+			result = result && objects[i].IsFlagSet( Reflex::ObjectFlags::ConstructionComplete );
+			result = result && objects[i].GetTransform()->getPosition() == sf::Vector2f( i + 1.0f, i + 1.0f );
+			result = result && movement->ContainsObject( objects[i] );
+		}
+
+		for( auto object : objects )
+			object.Destroy();
+
+		return result;
+	}
+
+	bool TestSystemMembership()
+	{
+		auto object = GetWorld().CreateObject();
+		auto object2 = GetWorld().CreateObject();
+		const auto* movement = GetWorld().GetSystem< Reflex::Systems::MovementSystem >();
+		const auto* steering = GetWorld().GetSystem< Reflex::Systems::SteeringSystem >();
+
+		object.AddComponent< Reflex::Components::Steering >();
+		object2.AddComponent< Reflex::Components::Steering >();
+		const auto added = steering->ContainsObject( object ) && steering->ContainsObject( object2 );
+
+		// Removing a component only takes the object out of the systems that required it
+		object.RemoveComponent< Reflex::Components::Steering >();
+		const auto removed = !steering->ContainsObject( object ) && steering->ContainsObject( object2 ) && movement->ContainsObject( object );
+
+		object.Destroy();
+		object2.Destroy();
+		return added && removed && !movement->ContainsObject( object );
+	}
+
+	bool TestObjectIndexReuse()
+	{
+		auto& world = GetWorld();
+		const auto before = world.GetObjectMetrics();
+
+		auto object = world.CreateObject();
+		const auto index = object.GetIndex();
+		object.Destroy();
+
+		// The index is recycled but handles to the destroyed object stay invalid
+		auto object2 = world.CreateObject();
+		const auto reused = object2.GetIndex() == index && object2.GetCounter() != object.GetCounter() && !object.IsValid() && object2.IsValid();
+		const auto metrics = world.GetObjectMetrics();
+
+		object2.Destroy();
+		return reused && metrics.live == before.live + 1 && metrics.peak >= metrics.live && metrics.reused > before.reused;
+	}
+
+	bool TestCompact()
+	{
+		std::vector< sf::Vector2f > positions;
+		for( unsigned i = 0; i < 2048; ++i )
+			positions.emplace_back( ( float )i, 0.0f );
+
+		std::vector< Reflex::Object > objects;
+		GetWorld().CreateObjects( positions, objects, 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+
+		for( auto& object : objects )
+			object.AddComponent< Reflex::Components::Steering >();
+
+		// Destroying all but the last two leaves mostly empty chunks, and the survivors back filled out of order
+		for( std::size_t i = 0; i < objects.size() - 2; ++i )
+			objects[i].Destroy();
+
+		const auto released = GetWorld().Compact( true );
+		bool result = released > 0;
+
+		for( std::size_t i = objects.size() - 2; i < objects.size(); ++i )
+		{
+			result = result && objects[i].GetTransform()->getPosition() == positions[i];
+			result = result && objects[i].HasComponent< Reflex::Components::Steering >();
+			objects[i].Destroy();
+		}
+
+		return result;
+	}
+
+	bool TestLinearArena()
+	{
+		Reflex::Core::LinearArena arena( 1024 );
+
+		{
+			Reflex::Core::FrameVector< int > values( &arena );
+			values.reserve( 128 );
+		}
+
+		// 512 bytes fits in the block, the second allocation doesn't
+		const auto first = arena.GetUsed() >= 512 && arena.GetOverflowCount() == 0;
+
+		{
+			Reflex::Core::FrameVector< int > values( &arena );
+			values.reserve( 256 );
+		}
+
+		const auto overflowed = arena.GetOverflowCount() == 1;
+		arena.Reset();
+
+		// After the reset the block covers both allocations
+		const auto grown = arena.GetUsed() == 0 && arena.GetCapacity() >= 1536;
+
+		{
+			Reflex::Core::FrameVector< int > values( &arena );
+			values.reserve( 128 );
+			Reflex::Core::FrameVector< int > values2( &arena );
+			values2.reserve( 256 );
+		}
+
+		// Over aligned allocations are aligned by address, not just by offset into the block
+		arena.Reset();
+		const auto* unaligned = static_cast< const char* >( arena.allocate( 1, 1 ) );
+		const auto* aligned = static_cast< const char* >( arena.allocate( 64, 64 ) );
+		const auto overAligned = reinterpret_cast< std::uintptr_t >( aligned ) % 64 == 0 && aligned > unaligned;
+
+		return first && overflowed && grown && overAligned && arena.GetOverflowCount() == 1;
+	}
+
+	// Counts the bytes currently allocated through it
+	struct CountingResource : public std::pmr::memory_resource
+	{
+		std::size_t allocated = 0;
+
+		void* do_allocate( const std::size_t bytes, const std::size_t alignment ) override { allocated += bytes; return std::pmr::new_delete_resource()->allocate( bytes, alignment ); }
+		void do_deallocate( void* ptr, const std::size_t bytes, const std::size_t alignment ) override { allocated -= bytes; std::pmr::new_delete_resource()->deallocate( ptr, bytes, alignment ); }
+		bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override { return this == &other; }
+	};
+
+	bool TestWorldMemoryResource()
+	{
+		// Counts what the monotonic buffer requests from upstream (frees are never passed through until the buffer is released)
+		CountingResource counting;
+		bool result = true;
+
+		{
+			std::pmr::monotonic_buffer_resource buffer( &counting );
+
+			{
+				Reflex::Core::World world( Reflex::Core::Context( GetWorld().GetWindow(), GetWorld().GetTextureManager(), GetWorld().GetFontManager() ), GetWorld().GetBounds(), sf::Vector2f( 0.0f, 9.8f ), Reflex::Core::World::StorageMode::SparseSet, &buffer );
+				const auto afterSetup = counting.allocated;
+
+				std::vector< Reflex::Object > objects;
+				world.CreateObjects( 256, objects );
+
+				for( auto& object : objects )
+					object.AddComponent< Reflex::Components::Steering >();
+
+				result = afterSetup > 0 && counting.allocated > afterSetup && objects.back().HasComponent< Reflex::Components::Steering >();
+			}
+		}
+
+		// Releasing the buffer returns everything in one go
+		return result && counting.allocated == 0;
+	}
+
+	bool TestEngineMemoryResource()
+	{
+		CountingResource counting;
+		bool result = true;
+
+		{
+			Reflex::Core::Engine::EngineParams params;
+			params.cmdMode = true;
+			params.worldMemoryResource = &counting;
+
+			Reflex::Core::Engine engine( params );
+			result = engine.GetWorld().GetMemoryResource() == &counting && counting.allocated > 0;
+		}
+
+		return result && counting.allocated == 0;
+	}
+
+	bool TestSystemSchedule()
+	{
+		const auto& schedule = GetWorld().GetSchedule();
+		bool result = true;
+		std::size_t movementStage = 0, steeringStage = 0;
+
+		for( std::size_t stage = 0; stage < schedule.size(); ++stage )
+		{
+			for( std::size_t i = 0; i < schedule[stage].size(); ++i )
+			{
+				for( std::size_t j = i + 1; j < schedule[stage].size(); ++j )
+					result = result && !schedule[stage][i]->ConflictsWith( *schedule[stage][j] );
+
+				if( schedule[stage][i] == GetWorld().GetSystem< Reflex::Systems::MovementSystem >() )
+					movementStage = stage;
+				if( schedule[stage][i] == GetWorld().GetSystem< Reflex::Systems::SteeringSystem >() )
+					steeringStage = stage;
+			}
+		}
+
+		// Both write transforms, so steering (added after movement) must update after it
+		return result && movementStage < steeringStage;
+	}
+
+	bool TestJobSystem()
+	{
+		auto& jobSystem = Reflex::Core::JobSystem::GetJobSystem();
+		std::atomic< unsigned > total = 0;
+		Reflex::Core::JobCounter counter;
+
+		for( unsigned i = 0; i < 64; ++i )
+		{
+			jobSystem.Run( [&]()
+			{
+				// Nested jobs go on the running worker's own deque, where idle workers can steal them
+				for( unsigned j = 0; j < 16; ++j )
+					jobSystem.Run( [&]() { ++total; }, counter );
+			}, counter );
+		}
+
+		jobSystem.Wait( counter );
+		return total == 64 * 16 && counter.IsDone();
+	}
+
+	bool TestJobSystemExceptions()
+	{
+		auto& jobSystem = Reflex::Core::JobSystem::GetJobSystem();
+		std::atomic< unsigned > total = 0;
+		Reflex::Core::JobCounter counter;
+
+		for( unsigned i = 0; i < 16; ++i )
+		{
+			jobSystem.Run( [&, i]()
+			{
+				if( i == 8 )
+					throw std::runtime_error( "Job failed" );
+
+				++total;
+			}, counter );
+		}
+
+		bool threw = false;
+
+		try
+		{
+			jobSystem.Wait( counter );
+		}
+		catch( const std::runtime_error& )
+		{
+			threw = true;
+		}
+
+		// The other jobs still ran, and the counter can be used again without rethrowing
+		bool result = threw && total == 15 && counter.IsDone();
+		jobSystem.Run( [&]() { ++total; }, counter );
+		jobSystem.Wait( counter );
+
+		return result && total == 16;
+	}
+
+	// Records a new object (at the boid's position) for every boid from its parallel jobs
+	class TestCreateCommandsSystem : public Reflex::Systems::System
+	{
+	public:
+		using System::System;
+
+		std::vector< sf::Vector2f > m_created;
+
+		void RegisterComponents() final
+		{
+			RequiresComponentReadOnly( Reflex::Components::Steering );
+			ReadsComponent( Reflex::Components::Transform );
+			m_exclusive = false;
+		}
+
+		void Update( const float deltaTime ) final
+		{
+			ParallelForEachObjectWithCommands< Reflex::Components::Steering >( [&]( Reflex::Core::CommandBuffer& commands, const Reflex::Components::Steering::Handle& boid )
+			{
+				commands.CreateObject( boid->GetTransform()->getPosition(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false, [this]( const Reflex::Object& object )
+				{
+					m_created.push_back( object.GetTransform()->getPosition() );
+					object.Destroy();
+				} );
+			} );
+		}
+	};
+
+	// Records removing every boid's steering component from its parallel jobs
+	class TestRemoveCommandsSystem : public Reflex::Systems::System
+	{
+	public:
+		using System::System;
+
+		void RegisterComponents() final
+		{
+			RequiresComponentReadOnly( Reflex::Components::Steering );
+			m_exclusive = false;
+		}
+
+		void Update( const float deltaTime ) final
+		{
+			ParallelForEachObjectWithCommands< Reflex::Components::Steering >( []( Reflex::Core::CommandBuffer& commands, const Reflex::Components::Steering::Handle& boid )
+			{
+				commands.RemoveComponent< Reflex::Components::Steering >( boid->GetObject() );
+			} );
+		}
+	};
+
+	bool TestParallelStageCommands()
+	{
+		// Enough boids for both systems to split them into several batches
+		std::vector< Reflex::Object > objects;
+		for( unsigned i = 0; i < 2000; ++i )
+			objects.push_back( GetWorld().CreateObject( sf::Vector2f( ( float )i, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false ) );
+
+		for( auto& object : objects )
+			object.AddComponent< Reflex::Components::Steering >();
+
+		auto* creator = GetWorld().AddSystem< TestCreateCommandsSystem >();
+		auto* remover = GetWorld().AddSystem< TestRemoveCommandsSystem >();
+
+		bool sameStage = false;
+		for( const auto& stage : GetWorld().GetSchedule() )
+			sameStage = sameStage || ( std::find( stage.begin(), stage.end(), creator ) != stage.end() && std::find( stage.begin(), stage.end(), remover ) != stage.end() );
+
+		std::vector< sf::Vector2f > expected;
+		for( const auto& object : creator->GetObjects() )
+			expected.push_back( object.GetTransform()->getPosition() );
+
+		GetWorld().Update( 0.0f );
+
+		// The creates are applied in the order the creator visited the boids, however the batches were spread across the threads
+		const auto created = creator->m_created == expected;
+		const auto removed = std::none_of( objects.begin(), objects.end(), []( const Reflex::Object& object ) { return object.HasComponent< Reflex::Components::Steering >(); } );
+
+		GetWorld().RemoveSystem< TestRemoveCommandsSystem >();
+		GetWorld().RemoveSystem< TestCreateCommandsSystem >();
+
+		for( auto& object : objects )
+			object.Destroy();
+
+		return sameStage && created && removed;
+	}
+
+	// Counts how often the world asks it about / adds / removes an object with the component
+	template< class T >
+	class TestObserverSystem : public Reflex::Systems::System
+	{
+	public:
+		using System::System;
+
+		mutable unsigned m_queries = 0;
+		unsigned m_added = 0;
+		unsigned m_removed = 0;
+
+		void RegisterComponents() final
+		{
+			RequiresComponentReadOnly( T );
+			m_exclusive = false;
+		}
+
+		bool ShouldAddObject( const Reflex::Object& object, const ComponentsMask& components ) const final
+		{
+			++m_queries;
+			return System::ShouldAddObject( object, components );
+		}
+
+		void OnComponentAdded( const Reflex::Object& object ) final { ++m_added; }
+		void OnComponentRemoved( const Reflex::Object& object ) final { ++m_removed; }
+	};
+
+	bool TestComponentObservers()
+	{
+		using SteeringObserver = TestObserverSystem< Reflex::Components::Steering >;
+		using CircleObserver = TestObserverSystem< Reflex::Components::CircleShape >;
+
+		auto* steering = GetWorld().AddSystem< SteeringObserver >();
+		auto* circle = GetWorld().AddSystem< CircleObserver >();
+		auto object = GetWorld().CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+
+		steering->m_queries = circle->m_queries = 0;
+
+		// Each change must reach the system observing its family, and only that system (the counts are reset after each check)
+		const auto counts = []( auto* system, const unsigned queries, const unsigned added, const unsigned removed )
+		{
+			const auto result = system->m_queries == queries && system->m_added == added && system->m_removed == removed;
+			system->m_queries = system->m_added = system->m_removed = 0;
+			return result;
+		};
+
+		object.AddComponent< Reflex::Components::Steering >();
+		bool result = counts( steering, 1, 1, 0 ) && counts( circle, 0, 0, 0 ) && steering->ContainsObject( object );
+
+		object.AddComponent< Reflex::Components::CircleShape >();
+		result = result && counts( steering, 0, 0, 0 ) && counts( circle, 1, 1, 0 ) && circle->ContainsObject( object );
+
+		object.RemoveComponent< Reflex::Components::Steering >();
+		result = result && counts( steering, 1, 0, 1 ) && counts( circle, 0, 0, 0 ) && !steering->ContainsObject( object ) && circle->ContainsObject( object );
+
+		object.Destroy();
+		GetWorld().RemoveSystem< CircleObserver >();
+		GetWorld().RemoveSystem< SteeringObserver >();
+		return result;
+	}
+
+	// Requires no components, so it should be given every object
+	class TestAllObjectsSystem : public Reflex::Systems::System
+	{
+	public:
+		using System::System;
+
+		void RegisterComponents() final
+		{
+			m_exclusive = false;
+		}
+	};
+
+	bool TestObserveAllComponents()
+	{
+		auto* system = GetWorld().AddSystem< TestAllObjectsSystem >();
+		auto object = GetWorld().CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+
+		const auto result = system->ContainsObject( object );
+		object.Destroy();
+
+		GetWorld().RemoveSystem< TestAllObjectsSystem >();
+		return result;
+	}
+
+	// Records which slice each update processed, the delta time it was given and every boid it visited
+	class TestRateLimitedSystem : public Reflex::Systems::System
+	{
+	public:
+		using System::System;
+
+		std::vector< std::pair< unsigned, float > > m_updates;
+		std::unordered_map< std::uint32_t, unsigned > m_visits;
+
+		void RegisterComponents() final
+		{
+			RequiresComponentReadOnly( Reflex::Components::Steering );
+			m_exclusive = false;
+		}
+
+		void Update( const float deltaTime ) final
+		{
+			m_updates.emplace_back( GetCurrentSlice(), deltaTime );
+
+			ForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& boid )
+			{
+				++m_visits[boid->GetObject().GetIndex()];
+			} );
+		}
+	};
+
+	bool TestSystemUpdateRate()
+	{
+		std::vector< Reflex::Object > objects;
+		for( unsigned i = 0; i < 4; ++i )
+			objects.push_back( GetWorld().CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false ) );
+
+		for( auto& object : objects )
+			object.AddComponent< Reflex::Components::Steering >();
+
+		auto* system = GetWorld().AddSystem< TestRateLimitedSystem >();
+		system->SetUpdateRate( 2.0f );
+		system->SetTimeSlices( 2 );
+
+		// Frames that don't divide the interval, 3 seconds should still be 6 updates (all of these values are exact in binary)
+		for( unsigned i = 0; i < 8; ++i )
+			GetWorld().Update( 0.375f );
+
+		// Each slice updates every other time, and is given the time since it last updated
+		const std::vector< std::pair< unsigned, float > > expected = { { 0, 0.75f }, { 1, 1.125f }, { 0, 0.75f }, { 1, 1.125f }, { 0, 1.125f }, { 1, 0.75f } };
+		bool result = system->m_updates == expected;
+
+		// Each slice has three updates, so every boid is visited three times
+		for( const auto& object : objects )
+			result = result && system->m_visits[object.GetIndex()] == 3;
+
+		GetWorld().RemoveSystem< TestRateLimitedSystem >();
+
+		for( auto& object : objects )
+			object.Destroy();
+
+		return result;
+	}
+
+	bool TestChangeTracking()
+	{
+		auto parent = GetWorld().CreateObject( sf::Vector2f( 10.0f, 0.0f ) );
+		auto child = GetWorld().CreateObject( sf::Vector2f( 5.0f, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false );
+		parent.GetTransform()->AttachChild( child );
+
+		const auto before = child.GetTransform()->GetWorldPosition() == sf::Vector2f( 15.0f, 0.0f );
+
+		// The child's world transform is cached, moving the parent has to invalidate it
+		parent.GetTransform()->setPosition( sf::Vector2f( 20.0f, 0.0f ) );
+		const auto after = child.GetTransform()->GetWorldPosition() == sf::Vector2f( 25.0f, 0.0f );
+		const auto stamped = parent.GetTransform()->GetChangeTick() == GetWorld().GetChangeTick();
+
+		child.Destroy();
+		parent.Destroy();
+		return before && after && stamped;
+	}
+
+	bool TestWorldTransformRelocation()
+	{
+		// The parent's transform is created last, so destroying the filler back fills its slot by moving the parent
+		auto child = GetWorld().CreateObject( sf::Vector2f( 5.0f, 0.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false );
+		auto filler = GetWorld().CreateObject();
+		auto parent = GetWorld().CreateObject( sf::Vector2f( 10.0f, 0.0f ) );
+		parent.GetTransform()->AttachChild( child );
+
+		const auto before = child.GetTransform()->GetWorldPosition() == sf::Vector2f( 15.0f, 0.0f );
+		filler.Destroy();
+
+		parent.GetTransform()->setPosition( sf::Vector2f( 20.0f, 0.0f ) );
+		const auto after = child.GetTransform()->GetWorldPosition() == sf::Vector2f( 25.0f, 0.0f );
+
+		child.Destroy();
+		parent.Destroy();
+		return before && after;
+	}
+
+	bool TestPrefabInstancing()
+	{
+		using Reflex::Components::Steering;
+		GetWorld().RegisterComponent< Reflex::Components::CircleShape >();
+		GetWorld().RegisterComponent< Steering >();
+
+		// Steering isn't clonable, its reflected fields are stored parsed instead
+		{
+			std::ofstream file( "TestPrefab.ro" );
+			file << R"({ "Components" : { "CircleShape" : {}, "Steering" : { "Mass" : "2.5", "Arrival" : "true" }, "Transform" : { "Rotation" : "45" } } })";
+		}
+
+		const auto& prefab = GetWorld().GetPrefab( "TestPrefab.ro" );
+		const auto cached = &GetWorld().GetPrefab( "TestPrefab.ro" ) == &prefab;
+		std::remove( "TestPrefab.ro" );
+
+		std::vector< Reflex::Object > objects;
+		GetWorld().Instantiate( prefab, 3, objects );
+
+		bool result = cached && objects.size() == 3;
+
+		for( auto& object : objects )
+		{
+			result = result && object.HasComponent< Reflex::Components::CircleShape >() && object.GetTransform()->getRotation() == 45.0f;
+
+			const auto steering = object.GetComponent< Steering >();
+			result = result && steering.IsValid() && Steering::GetTypeInfo().FindField( "Mass" )->Get< float >( steering.Get() ) == 2.5f && steering->IsBehaviourSet( Reflex::Components::SteeringBehaviours::Arrival );
+			object.Destroy();
+		}
+
+		// An invalid file throws part way through building the prefab, which mustn't leave the scratch object behind
+		{
+			std::ofstream file( "TestPrefabInvalid.ro" );
+			file << R"({ "Components" : { "CircleShape" : { "Unknown" : "1" } } })";
+		}
+
+		const auto liveBefore = GetWorld().GetObjectMetrics().live;
+		bool threw = false;
+
+		try
+		{
+			GetWorld().GetPrefab( "TestPrefabInvalid.ro" );
+		}
+		catch( const std::runtime_error& )
+		{
+			threw = true;
+		}
+
+		std::remove( "TestPrefabInvalid.ro" );
+		return result && threw && GetWorld().GetObjectMetrics().live == liveBefore;
+	}
+
+	bool TestWorldSnapshot()
+	{
+		auto parent = GetWorld().CreateObject( sf::Vector2f( 10.0f, 20.0f ), 30.0f );
+		auto child = GetWorld().CreateObject( sf::Vector2f( 5.0f, 0.0f ) );
+		parent.GetTransform()->AttachChild( child );
+
+		bool result = GetWorld().SaveSnapshot( "TestSnapshot.bin" );
+		parent.Destroy();
+
+		result = result && GetWorld().LoadSnapshot( "TestSnapshot.bin" );
+		std::remove( "TestSnapshot.bin" );
+
+		result = result && parent.IsValid() && child.IsValid()
+			&& parent.GetTransform()->getPosition() == sf::Vector2f( 10.0f, 20.0f )
+			&& parent.GetTransform()->getRotation() == 30.0f
+			&& child.GetTransform()->GetParent() == parent;
+
+		parent.Destroy();
+		return result;
+	}
+
+	bool TestWorldSnapshotInvalid()
+	{
+		auto object = GetWorld().CreateObject( sf::Vector2f( 10.0f, 20.0f ) );
+		bool result = GetWorld().SaveSnapshot( "TestSnapshot.bin" );
+
+		// Cut off part of the last component's data
+		std::filesystem::resize_file( "TestSnapshot.bin", std::filesystem::file_size( "TestSnapshot.bin" ) - 4 );
+		bool threw = false;
+
+		try
+		{
+			GetWorld().LoadSnapshot( "TestSnapshot.bin" );
+		}
+		catch( const std::runtime_error& )
+		{
+			threw = true;
+		}
+
+		std::remove( "TestSnapshot.bin" );
+		result = result && threw && object.IsValid() && object.GetTransform()->getPosition() == sf::Vector2f( 10.0f, 20.0f );
+
+		// A two object snapshot with the given transform indices and transform data
+		const auto load = [&]( const std::vector< std::uint32_t >& indices, const std::vector< char >& data )
+		{
+			const std::uint32_t counters[] = { 0, 0 }, flags[] = { 0, 0 };
+			Reflex::Core::SnapshotWriter writer;
+			writer.Write( Reflex::Core::SnapshotMagic );
+			writer.Write( Reflex::Core::SnapshotVersion );
+			writer.WriteArray( counters, 2 );
+			writer.WriteArray( flags, 2 );
+			writer.WriteArray< std::uint32_t >( nullptr, 0 );
+			writer.Write( std::uint32_t( 0 ) );
+			writer.Write( Reflex::SparseIndex::InvalidIndex );
+			writer.Write( std::uint32_t( 1 ) );
+			writer.WriteString( Reflex::Components::Transform::GetComponentName() );
+			writer.WriteArray( indices.data(), indices.size() );
+			writer.Write( ( std::uint64_t )data.size() );
+			writer.WriteBytes( data.data(), data.size() );
+
+			for( std::size_t i = 0; i < indices.size(); ++i )
+			{
+				writer.Write( Reflex::SparseIndex::InvalidIndex );
+				writer.WriteArray< std::uint32_t >( nullptr, 0 );
+			}
+
+			writer.SaveToFile( "TestSnapshot.bin" );
+
+			try
+			{
+				GetWorld().LoadSnapshot( "TestSnapshot.bin" );
+			}
+			catch( const std::runtime_error& )
+			{
+				std::remove( "TestSnapshot.bin" );
+				return true;
+			}
+
+			std::remove( "TestSnapshot.bin" );
+			return false;
+		};
+
+		// A repeated index, or a live object without a transform, is found before the world is touched
+		result = result && load( { 0, 0 }, {} ) && object.IsValid();
+		result = result && load( { 0 }, {} ) && object.IsValid();
+
+		// Transform data that is too short is only found once the world has been cleared, which leaves it empty with a new scene root
+		result = result && load( { 0, 1 }, std::vector< char >( 4 ) ) && !object.IsValid();
+		result = result && GetWorld().GetObjectMetrics().live == 1 && GetWorld().GetSceneRoot().IsValid();
+
+		return result;
+	}
+
+	bool TestComponentReflection()
+	{
+		using Reflex::Components::Steering;
+		const auto& type = Steering::GetTypeInfo();
+		const auto* mass = type.FindField( "Mass" );
+
+		auto object = GetWorld().CreateObject();
+		auto steering = object.AddComponent< Steering >();
+		bool result = mass && mass->type == Reflex::Core::FieldType::Float && !type.FindField( "Unknown" );
+		result = result && type.SetValue( steering.Get(), "Mass", "2.5" ) && type.SetValue( steering.Get(), "Arrival", "true" );
+		result = result && mass->Get< float >( steering.Get() ) == 2.5f && steering->IsBehaviourSet( Reflex::Components::SteeringBehaviours::Arrival );
+
+		std::vector< std::pair< std::string, std::string > > values;
+		type.GetValues( steering.Get(), values );
+		const auto found = std::find( values.begin(), values.end(), std::make_pair( std::string( "Mass" ), std::string( "2.5" ) ) );
+		result = result && found != values.end() && GetWorld().GetComponentTypeInfo( Steering::GetFamily() ) == &type;
+
+		object.Destroy();
+		return result;
+	}
+
+	bool TestStringConversion()
+	{
+		const auto vec = Reflex::FromString< sf::Vector2f >( Reflex::ToString( sf::Vector2f( 1.5f, -2.25f ) ) );
+		const auto colour = Reflex::FromString< sf::Color >( Reflex::ToString( sf::Color( 10, 20, 30, 40 ) ) );
+		const auto parts = Reflex::SplitView( "a, b,c", ',' );
+
+		return vec == sf::Vector2f( 1.5f, -2.25f )
+			&& colour == sf::Color( 10, 20, 30, 40 )
+			&& Reflex::FromString< unsigned >( "42" ) == 42U
+			&& Reflex::FromString< bool >( Reflex::ToString( true ) )
+			&& Reflex::FromString< std::string >( "  first second" ) == "first"
+			&& Reflex::FromString< std::string >( " " ).empty()
+			&& parts.size() == 3 && Reflex::TrimView( parts[1] ) == "b";
+	}
+
+	bool TestAsyncResourceLoading()
+	{
+		using Reflex::ResourceID;
+
+		sf::Image image;
+		image.create( 4, 4, sf::Color::Red );
+		image.saveToFile( "TestTexture.png" );
+		image.create( 1, 1, sf::Color::Magenta );
+		image.saveToFile( "TestPlaceholder.png" );
+
+		Reflex::Core::TextureManager textures;
+		textures.LoadPlaceholder( "TestPlaceholder.png" );
+
+		const auto loaded = textures.LoadResourceAsync( ResourceID::TestTexture, "TestTexture.png" );
+		const auto duplicate = textures.LoadResourceAsync( ResourceID::TestTextureDuplicate, "TestTexture.png" );
+		const auto missing = textures.LoadResourceAsync( ResourceID::TestTextureMissing, "TestMissing.png" );
+
+		// Nothing is finished until Update, until then both ids share one resource holding the placeholder
+		const auto& texture = textures.GetResource( ResourceID::TestTexture );
+		bool result = &texture == &textures.GetResource( ResourceID::TestTextureDuplicate ) && textures.GetPendingCount() == 2 && texture.getSize() == sf::Vector2u( 1, 1 );
+
+		while( textures.GetPendingCount() )
+		{
+			textures.Update();
+			std::this_thread::yield();
+		}
+
+		result = result && loaded.get() && duplicate.get() && !missing.get()
+			&& texture.getSize() == sf::Vector2u( 4, 4 )
+			&& textures.GetResource( ResourceID::TestTextureMissing ).getSize() == sf::Vector2u( 1, 1 );
+
+		std::remove( "TestTexture.png" );
+		std::remove( "TestPlaceholder.png" );
+		return result;
+	}
+
+	bool TestRegionStreaming()
+	{
+		auto& streamer = GetWorld().GetRegionStreamer();
+		streamer.Enable( "TestRegions", 0.0f, 0.0f );
+
+		const auto position = sf::Vector2f( 100000.0f, 100000.0f );
+		const auto region = streamer.GetRegion( position );
+		streamer.LoadRegion( region );
+		streamer.Flush();
+
+		auto object = GetWorld().CreateObject( position );
+		object.GetTransform()->AttachChild( GetWorld().CreateObject( sf::Vector2f( 5.0f, 5.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false ) );
+
+		bool result = streamer.IsRegionLoaded( region );
+		streamer.UnloadRegion( region );
+		streamer.Flush();
+		result = result && !object.IsValid() && !streamer.IsRegionLoaded( region );
+
+		streamer.LoadRegion( region );
+		streamer.Flush();
+
+		const auto sceneRoot = GetWorld().GetSceneRoot();
+		Reflex::Object loaded;
+
+		for( unsigned i = 0; i < sceneRoot->GetChildrenCount(); ++i )
+			if( sceneRoot->GetChild( i ).GetTransform()->getPosition() == position )
+				loaded = sceneRoot->GetChild( i );
+
+		result = result && loaded.IsValid() && loaded.GetTransform()->GetChildrenCount() == 1
+			&& loaded.GetTransform()->GetChild( 0 ).GetTransform()->getPosition() == sf::Vector2f( 5.0f, 5.0f );
+
+		if( loaded.IsValid() )
+		{
+			loaded.GetTransform()->GetChild( 0 ).Destroy();
+			loaded.Destroy();
+		}
+
+		streamer.Disable();
+		std::filesystem::remove_all( "TestRegions" );
+		return result;
+	}
+
+	bool TestRegionStreamingDisable()
+	{
+		auto& streamer = GetWorld().GetRegionStreamer();
+		streamer.Enable( "TestRegions", 0.0f, 0.0f );
+
+		const auto position = sf::Vector2f( 100000.0f, 100000.0f );
+		const auto region = streamer.GetRegion( position );
+		streamer.LoadRegion( region );
+		streamer.Flush();
+
+		auto object = GetWorld().CreateObject( position );
+		const auto path = streamer.GetRegionFile( region );
+		streamer.Disable();
+		bool result = !object.IsValid() && std::filesystem::exists( path );
+
+		streamer.Enable( "TestRegions", 0.0f, 0.0f );
+		streamer.LoadRegion( region );
+		streamer.Flush();
+
+		// The object is read back once
+		const auto sceneRoot = GetWorld().GetSceneRoot();
+		std::vector< Reflex::Object > loaded;
+
+		for( unsigned i = 0; i < sceneRoot->GetChildrenCount(); ++i )
+			if( sceneRoot->GetChild( i ).GetTransform()->getPosition() == position )
+				loaded.push_back( sceneRoot->GetChild( i ) );
+
+		result = result && loaded.size() == 1;
+
+		for( auto& found : loaded )
+			found.Destroy();
+
+		streamer.Disable();
+		std::filesystem::remove_all( "TestRegions" );
+		return result;
+	}
+
+	bool TestRegionStreamingInvalidFile()
+	{
+		auto& streamer = GetWorld().GetRegionStreamer();
+		streamer.Enable( "TestRegions", 0.0f, 0.0f );
+
+		const auto position = sf::Vector2f( 100000.0f, 100000.0f );
+		const auto region = streamer.GetRegion( position );
+		streamer.LoadRegion( region );
+		streamer.Flush();
+
+		GetWorld().CreateObject( position );
+		streamer.UnloadRegion( region );
+		streamer.Flush();
+
+		// As if the save had been cut short
+		const auto path = streamer.GetRegionFile( region );
+		std::filesystem::resize_file( path, std::filesystem::file_size( path ) - 1 );
+
+		const auto live = GetWorld().GetObjectMetrics().live;
+		bool result = true;
+
+		try
+		{
+			streamer.LoadRegion( region );
+			streamer.Flush();
+			result = streamer.IsRegionLoaded( region ) && GetWorld().GetObjectMetrics().live == live;
+		}
+		catch( const std::exception& )
+		{
+			result = false;
+		}
+
+		streamer.Disable();
+		std::filesystem::remove_all( "TestRegions" );
+		return result;
+	}
+
+	bool TestReadObjectsInvalid()
+	{
+		using Reflex::Components::Steering;
+
+		auto object = GetWorld().CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+		Reflex::Core::SnapshotWriter without;
+		GetWorld().WriteObjects( { object }, without );
+
+		object.AddComponent< Steering >();
+		Reflex::Core::SnapshotWriter writer;
+		GetWorld().WriteObjects( { object }, writer );
+		object.Destroy();
+
+		const auto metrics = GetWorld().GetObjectMetrics();
+
+		// Reads the data, which must throw without changing the world
+		const auto rejected = [&]( const std::vector< char >& data )
+		{
+			Reflex::Core::SnapshotReader reader( data.data(), data.size() );
+			std::vector< Reflex::Object > objects;
+			bool threw = false;
+
+			try
+			{
+				GetWorld().ReadObjects( reader, objects );
+			}
+			catch( const std::runtime_error& )
+			{
+				threw = true;
+			}
+
+			const auto after = GetWorld().GetObjectMetrics();
+			return threw && objects.empty() && after.live == metrics.live && after.free == metrics.free && after.capacity == metrics.capacity;
+		};
+
+		// Truncated, caught before anything is created
+		std::vector< char > data( writer.GetData(), writer.GetData() + writer.GetSize() - 1 );
+		bool result = rejected( data );
+
+		// The steering data (written last) claims to be 4 bytes shorter, so steering reads past it once it has been constructed
+		const auto steeringBytes = writer.GetSize() - without.GetSize() - sizeof( std::uint32_t ) * 2 - Steering::GetComponentName().size();
+		const auto sizeOffset = writer.GetSize() - steeringBytes - sizeof( std::uint32_t );
+		data.assign( writer.GetData(), writer.GetData() + writer.GetSize() - 4 );
+		const auto shortened = std::uint32_t( steeringBytes - 4 );
+		std::memcpy( data.data() + sizeOffset, &shortened, sizeof( shortened ) );
+
+		return result && rejected( data );
+	}
+
+	bool TestCommandBuffer()
+	{
+		auto& commands = GetWorld().GetCommandBuffer();
+		auto object = GetWorld().CreateObject();
+		auto object2 = GetWorld().CreateObject();
+		Reflex::Object created;
+
+		commands.CreateObject( sf::Vector2f( 1.0f, 1.0f ), 0.0f, sf::Vector2f( 1.0f, 1.0f ), true, true, [&]( const Reflex::Object& newObject ) { created = newObject; } );
+		commands.AddComponent< Reflex::Components::Steering >( object );
+		commands.AddComponent< Reflex::Components::Steering >( object2 );
+		commands.RemoveComponent< Reflex::Components::Steering >( object2 );
+		commands.DestroyObject( object2 );
+
+		// Nothing is applied until the flush
+		const auto deferred = !created.IsValid() && !object.HasComponent< Reflex::Components::Steering >() && object2.IsValid();
+		GetWorld().FlushCommands();
+
+		const auto applied = created.IsValid() && object.HasComponent< Reflex::Components::Steering >() && !object2.IsValid() && commands.Empty();
+
+		object.Destroy();
+		created.Destroy();
+		return deferred && applied;
+	}
+
+	bool TestCommandBufferNestedFlush()
+	{
+		auto& commands = GetWorld().GetCommandBuffer();
+		Reflex::Object first, second;
+		unsigned firstCreated = 0;
+
+		// The first callback records a change and flushes it straight away, while the outer flush is still going through its commands
+		commands.CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false, [&]( const Reflex::Object& newObject )
+		{
+			first = newObject;
+			++firstCreated;
+			commands.AddComponent< Reflex::Components::Steering >( newObject );
+			GetWorld().FlushCommands();
+		} );
+		commands.CreateObject( sf::Vector2f(), 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false, [&]( const Reflex::Object& newObject ) { second = newObject; } );
+
+		GetWorld().FlushCommands();
+
+		const auto result = firstCreated == 1 && first.HasComponent< Reflex::Components::Steering >() && second.IsValid() && commands.Empty();
+
+		first.Destroy();
+		second.Destroy();
+		return result;
+	}
+
+	static constexpr unsigned BenchmarkObjectCount = 10000;
+
+	std::vector< Reflex::Object > CreateBenchmarkObjects( const bool steering )
+	{
+		std::vector< sf::Vector2f > positions;
+		positions.reserve( BenchmarkObjectCount );
+
+		for( unsigned i = 0; i < BenchmarkObjectCount; ++i )
+			positions.emplace_back( ( float )i, 0.0f );
+
+		std::vector< Reflex::Object > objects;
+		GetWorld().CreateObjects( positions, objects, 0.0f, sf::Vector2f( 1.0f, 1.0f ), false, false );
+
+		for( auto& object : objects )
+		{
+			object.GetTransform()->SetVelocity( sf::Vector2f( 1.0f, 1.0f ) );
+
+			if( steering )
+				object.AddComponent< Reflex::Components::Steering >();
+		}
+
+		return objects;
+	}
+
+	void ReportBenchmark( const std::string& name, const sf::Time handles, const sf::Time view ) const
+	{
+		OnMessage( Stream( "\t" << name << ": handles " << handles.asMicroseconds() * 1000 / BenchmarkObjectCount << "ns / object, view " << view.asMicroseconds() * 1000 / BenchmarkObjectCount << "ns / object" ) );
+	}
+
+	bool BenchmarkMovementIteration()
+	{
+		const auto objects = CreateBenchmarkObjects( false );
+		const auto* movement = GetWorld().GetSystem< Reflex::Systems::MovementSystem >();
+		const auto view = GetWorld().View< Reflex::Components::Transform >();
+		const float deltaTime = 1.0f / 60.0f;
+
+		sf::Clock clock;
+		movement->ForEachObject< Reflex::Components::Transform >( [&]( const Reflex::Components::Transform::Handle& transform )
+		{
+			transform->setPosition( transform->getPosition() + transform->GetVelocity() * deltaTime );
+		} );
+		const auto handles = clock.restart();
+
+		view.ForEach( [&]( Reflex::Components::Transform& transform )
+		{
+			transform.setPosition( transform.getPosition() + transform.GetVelocity() * deltaTime );
+		} );
+		ReportBenchmark( "Movement", handles, clock.restart() );
+
+		for( auto object : objects )
+			object.Destroy();
+
+		return true;
+	}
+
+	bool BenchmarkSteeringIteration()
+	{
+		const auto objects = CreateBenchmarkObjects( true );
+		const auto* steering = GetWorld().GetSystem< Reflex::Systems::SteeringSystem >();
+		const auto view = GetWorld().View< Reflex::Components::Steering, Reflex::Components::Transform >();
+		const float deltaTime = 1.0f / 60.0f;
+
+		sf::Clock clock;
+		steering->ForEachObject< Reflex::Components::Steering >( [&]( const Reflex::Components::Steering::Handle& boid )
+		{
+			auto transform = boid->GetObject().GetTransform();
+			const auto acceleration = sf::Vector2f( boid->m_maxForce, 0.0f ) / boid->m_mass;
+			transform->SetVelocity( transform->GetVelocity() + acceleration * deltaTime );
+		} );
+		const auto handles = clock.restart();
+
+		view.ForEach( [&]( Reflex::Components::Steering& boid, Reflex::Components::Transform& transform )
+		{
+			const auto acceleration = sf::Vector2f( boid.m_maxForce, 0.0f ) / boid.m_mass;
+			transform.SetVelocity( transform.GetVelocity() + acceleration * deltaTime );
+		} );
+		ReportBenchmark( "Steering", handles, clock.restart() );
+
+		for( auto object : objects )
+			object.Destroy();
+
+		return true;
+	}
+
+	bool BenchmarkWorldCreation()
+	{
+		const auto context = Reflex::Core::Context( GetWorld().GetWindow(), GetWorld().GetTextureManager(), GetWorld().GetFontManager() );
+		const Reflex::Core::World world( context, GetWorld().GetBounds() );
+
+		for( const auto& timing : world.GetStartupTimings() )
+			OnMessage( Stream( "\t" << timing.name << ": " << timing.time.asMicroseconds() << "us" ) );
+
+		return true;
+	}
+};
\ No newline at end of file